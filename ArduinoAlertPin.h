@@ -0,0 +1,98 @@
+#ifndef ArduinoAlertPin_h
+#define ArduinoAlertPin_h
+
+#ifndef Arduino
+    #include "Arduino.h"
+#endif
+
+#include "INA260Alert.h"
+
+#define INA260_ALERT_PINS               4 // ArduinoAlertPin instances that can be attached at once
+
+/*!
+ *  @brief ALERT pin source using attachInterrupt().
+ *
+ *  attachInterrupt() takes a plain function, so a fixed set of
+ *  trampolines (INA260_ALERT_PINS) dispatches to the attached instances.
+*/
+class ArduinoAlertPin {
+    private:
+        uint8_t pin;
+        int mode;
+        int8_t slot;
+        AlertHandler handler;
+        void *context;
+
+        static ArduinoAlertPin *&instance(uint8_t slot) {
+            static ArduinoAlertPin *instances[INA260_ALERT_PINS];
+            return instances[slot];
+        }
+
+        template <uint8_t Slot>
+        static void trampoline(void) {
+            ArduinoAlertPin *self = instance(Slot);
+            if (self != nullptr) {
+                self->handler(self->context, micros());
+            }
+        }
+
+    public:
+        /*!
+         *  @brief Instantiates a pin source.
+         *
+         *  @param pin The Arduino pin wired to ALERT.
+         *  @param activeHigh True if the Alert Polarity bit is set
+         *  (ALERT rises), false for the default active-low ALERT.
+        */
+        explicit ArduinoAlertPin(uint8_t pin, bool activeHigh = false) :
+            pin(pin),
+            mode(activeHigh ? RISING : FALLING),
+            slot(-1),
+            handler(nullptr),
+            context(nullptr) {}
+
+        /*!
+         *  @brief Attaches the interrupt. ALERT is open-drain, so the
+         *  internal pull-up is enabled.
+         *
+         *  @return True if attached, false if all slots are in use.
+        */
+        bool begin(AlertHandler handler, void *context) {
+            static void (*const trampolines[INA260_ALERT_PINS])(void) = {
+                trampoline<0>, trampoline<1>, trampoline<2>, trampoline<3>
+            };
+            end();
+            for (uint8_t i = 0; i < INA260_ALERT_PINS; i++) {
+                if (instance(i) == nullptr) {
+                    this->handler = handler;
+                    this->context = context;
+                    slot = i;
+                    instance(i) = this;
+                    pinMode(pin, INPUT_PULLUP);
+                    attachInterrupt(digitalPinToInterrupt(pin), trampolines[i], mode);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /*!
+         *  @brief Detaches the interrupt.
+        */
+        void end(void) {
+            if (slot >= 0) {
+                detachInterrupt(digitalPinToInterrupt(pin));
+                instance(slot) = nullptr;
+                slot = -1;
+            }
+        }
+
+        /*!
+         *  @brief Edges are delivered by the interrupt; nothing to do.
+        */
+        void service(uint32_t timeoutMicros) {
+            (void)timeoutMicros;
+        }
+};
+
+#endif // ArduinoAlertPin.H
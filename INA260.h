@@ -2,6 +2,13 @@
 #define INA260_h
 
 #include <stdint.h>
+#include <stddef.h>
+
+#include "INA260Clock.h"
+
+#ifdef ARDUINO
+    #include "Arduino.h"
+#endif
 
 #define INA260_I2CADDR_DEFAULT          0x40 // Default I2C address
 #define INA260_CONFIG_REGISTER          0x00 // Configuration Register
@@ -13,6 +20,17 @@
 #define INA260_MANUFACTURER_ID_REGISTER 0xFE // Manufacturer ID register
 #define INA260_DIE_ID_REGISTER          0xFF // Die ID and revision register
 
+#define INA260_MANUFACTURER_ID          0x5449 // "TI" in the Manufacturer ID register
+#define INA260_DIE_ID                   0x227  // Device ID field of the Die ID register
+
+#define INA260_CONFIG_DEFAULT           0x6127 // Configuration Register value after reset
+#define INA260_MASK_ENABLE_WRITABLE     0xFC03 // Mask/Enable bits that are not read-only flags
+
+#define INA260_TRIGGER_ATTEMPTS         4 // Ready checks measureOnce() makes before giving up
+#define INA260_SNAPSHOT_ATTEMPTS        4 // Tries readSnapshot() makes to read one conversion
+
+#include "INA260Stats.h"
+
 typedef enum _address {
     ADDRESS_0x40 = 0x40, // A1 = GND, A0 = GND
     ADDRESS_0x41 = 0x41, // A1 = GND, A0 = VS
@@ -65,6 +83,24 @@ typedef enum _conversion {
     TIME_8_244_ms   = 0b111, // Measurement time: 8.224ms
 } ConversionTime;
 
+typedef enum _status {
+    STATUS_OK           = 0, // Transaction completed
+    STATUS_READ_FAILED  = 1, // Register read was not acknowledged or returned too few bytes
+    STATUS_WRITE_FAILED = 2, // Register write was not acknowledged
+} Status;
+
+/*!
+ *  @brief A value read from the device together with the status of the
+ *  transaction that produced it. value is zero unless status is STATUS_OK.
+*/
+template <typename T>
+struct Reading {
+    T value;
+    Status status;
+
+    bool ok(void) const { return status == STATUS_OK; }
+};
+
 union ConfigurationRegister {
     struct __attribute__((packed)) {
         uint16_t mode : 3;
@@ -103,38 +139,224 @@ union DieIdRegister {
     uint16_t rawValue;
 };
 
-class INA260 {
+// Conversion times in microseconds, indexed by ConversionTime.
+static constexpr uint16_t ina260ConversionTimes[8] = { 140, 204, 332, 558, 1100, 2116, 4156, 8244 };
+
+/*!
+ *  @brief Gets the duration of one conversion.
+ *
+ *  @param time The conversion time setting.
+ *  @return The conversion time in microseconds.
+*/
+inline constexpr uint16_t conversionTimeMicros(ConversionTime time) {
+    return ina260ConversionTimes[time & 0x7];
+}
+
+/*!
+ *  @brief Gets the number of samples averaged per result.
+ *
+ *  @param count The averaging count setting.
+ *  @return The number of samples.
+*/
+inline constexpr uint16_t averagingSamples(AveragingCount count) {
+    return (count < AVG_128) ? (1 << (2 * count)) : (128 << (count - AVG_128));
+}
+
+/*!
+ *  @brief Gets the time the device takes to produce one averaged result
+ *  with the given configuration, i.e. the interval between Conversion
+ *  Ready flags in continuous mode and the duration of a triggered
+ *  measurement.
+ *
+ *  @param config The ConfigurationRegister value.
+ *  @return The time in microseconds, 0 in power-down modes.
+*/
+inline uint32_t conversionPeriodMicros(ConfigurationRegister config) {
+    uint32_t sample = 0;
+    if (config.mode & MODE_TRIG_ISH) {
+        sample += conversionTimeMicros(static_cast<ConversionTime>(config.ishct));
+    }
+    if (config.mode & MODE_TRIG_VBUS) {
+        sample += conversionTimeMicros(static_cast<ConversionTime>(config.vbusct));
+    }
+    return sample * averagingSamples(static_cast<AveragingCount>(config.avg));
+}
+
+/*!
+ *  @brief Raw current, bus voltage and power read back-to-back, together
+ *  with the MaskEnableRegister flags (CVRF, OVF, AFF) read alongside them.
+ *  Values are left unscaled: current is two's complement at 1.25 mA/LSB,
+ *  voltage is 1.25 mV/LSB and power is 10 mW/LSB.
+*/
+struct Snapshot {
+    uint16_t current;
+    uint16_t voltage;
+    uint16_t power;
+    MaskEnableRegister flags;
+};
+
+/*!
+ *  @brief A timestamped Snapshot in 12 bytes, as queued and published
+ *  by the acquisition helpers. flags is the MaskEnableRegister.
+*/
+struct RawSample {
+    uint32_t micros;
+    uint16_t current;
+    uint16_t voltage;
+    uint16_t power;
+    uint16_t flags;
+};
+
+static_assert(sizeof(RawSample) == 12, "RawSample must not be padded");
+
+/*!
+ *  @brief Timestamps a Snapshot as a RawSample.
+ *
+ *  @param snapshot The snapshot.
+ *  @param micros The sample timestamp.
+ *  @return The sample.
+*/
+inline RawSample rawSample(const Snapshot &snapshot, uint32_t micros) {
+    const RawSample sample = { micros, snapshot.current, snapshot.voltage, snapshot.power, snapshot.flags.rawValue };
+    return sample;
+}
+
+/*!
+ *  @brief Converts a raw Current register value to microamps. The
+ *  register is two's complement, so reverse current is negative.
+*/
+inline int32_t currentMicroAmps(uint16_t raw) {
+    return static_cast<int32_t>(static_cast<int16_t>(raw)) * 1250;
+}
+
+/*!
+ *  @brief Converts a raw Current register value to quarter milliamps
+ *  (mA x 4), which fits in 32 bits with headroom for accumulation.
+*/
+inline int32_t currentQuarterMilliAmps(uint16_t raw) {
+    return static_cast<int32_t>(static_cast<int16_t>(raw)) * 5;
+}
+
+/*!
+ *  @brief Converts a raw Bus Voltage register value to microvolts.
+*/
+inline uint32_t busVoltageMicroVolts(uint16_t raw) {
+    return static_cast<uint32_t>(raw) * 1250;
+}
+
+/*!
+ *  @brief Converts a raw Power register value to microwatts.
+*/
+inline uint32_t powerMicroWatts(uint16_t raw) {
+    return static_cast<uint32_t>(raw) * 10000;
+}
+
+/*!
+ *  @brief Outcome of INA260Device::scanDevices().
+*/
+struct ScanResult {
+    uint8_t found;          // Verified INA260s written to the caller's buffer
+    uint8_t probes;         // Addresses probed
+    uint8_t rejected;       // Devices that acknowledged but are not INA260s
+    uint32_t elapsedMicros; // Time the scan took
+};
+
+template <class Transport>
+class INA260Configuration;
+
+/*!
+ *  @brief Driver for a single INA260, parameterised on the bus transport.
+ *
+ *  A transport is any class providing begin(), probe(), write(), read(),
+ *  writeRead() and pointers(), the RegisterPointers it updates on every
+ *  transfer (see WireTransport for the reference implementation).
+ *  INA260AsyncReader additionally needs startRead(), startWriteRead()
+ *  and poll(). The transport is called directly, so on AVR/ARM the
+ *  compiler can inline the bus calls without any virtual dispatch.
+*/
+template <class Transport>
+class INA260Device {
     private:
+        Transport *bus;
         uint8_t address;
+        bool pointerCache;
+        bool shadowRegisters;
+        bool shadowValid;
+        ConfigurationRegister shadowConfig;
+        MaskEnableRegister shadowMaskEnable; // Writable bits only
+        Status lastStatus;
+#ifdef INA260_ENABLE_STATS
+        INA260Stats stats;
+#endif
+
+        Reading<MaskEnableRegister> maskEnableSettings(void);
 
     public:
-        byte devices[16];
+        uint8_t devices[16];
         int deviceCount;
 
-        INA260(void);
+        INA260Device(void);
+        INA260Device(Transport &bus, uint8_t addr = INA260_I2CADDR_DEFAULT);
 
         bool begin(void);
         bool reset(void);
 
         void findDevices(void);
+        ScanResult scanDevices(uint8_t *addresses, uint8_t capacity);
 
         void setAddress(uint8_t addr);
         uint8_t getAddress(void);
 
+        Transport &transport(void);
+
+        void setPointerCache(bool enabled);
+        void invalidatePointerCache(void);
+        bool isPointerCacheEnabled(void);
+
+        bool setShadowRegisters(bool enabled);
+        bool isShadowRegistersEnabled(void);
+        bool resync(void);
+
+        Status getLastStatus(void);
+
+#ifdef INA260_ENABLE_STATS
+        const INA260Stats &getStats(void) const { return stats; }
+        void resetStats(void) { stats.reset(); }
+#endif
+
         uint16_t readRegister(uint8_t reg);
+        bool readRegister(uint8_t reg, uint16_t &value);
+        Reading<uint16_t> tryReadRegister(uint8_t reg);
         bool writeRegister(uint8_t reg, uint16_t value);
 
         ConfigurationRegister readConfigurationRegister(void);
+        Reading<ConfigurationRegister> tryReadConfigurationRegister(void);
         bool writeConfigurationRegister(ConfigurationRegister value);
 
+        INA260Configuration<Transport> configure(void);
+        INA260Configuration<Transport> configureDefaults(void);
+
         float readCurrent(void);
         float readBusVoltage(void);
         float readPower(void);
 
+        Reading<float> tryReadCurrent(void);
+        Reading<float> tryReadBusVoltage(void);
+        Reading<float> tryReadPower(void);
+
+        int32_t readCurrentMicroAmps(void);
+        uint32_t readBusVoltageMicroVolts(void);
+        uint32_t readPowerMicroWatts(void);
+
+        bool readSnapshot(Snapshot &snapshot, bool sameConversion = false);
+        bool measureOnce(Snapshot &snapshot, INA260SleepFunction sleep = ina260SleepMicros);
+
         MaskEnableRegister readMaskEnableRegister(void);
+        Reading<MaskEnableRegister> tryReadMaskEnableRegister(void);
         bool writeMaskEnableRegister(MaskEnableRegister reg);
 
         double readAlertLimitRegister(void);
+        Reading<double> tryReadAlertLimitRegister(void);
         bool writeAlertLimitRegister(uint16_t value);
 
         bool enableOverCurrentLimitAlert(uint16_t milliAmps);
@@ -172,9 +394,54 @@ class INA260 {
         AveragingCount getAveragingCount(void);
         bool setAveragingCount(AveragingCount count);
 
+#ifdef ARDUINO
         String readManufactuerId(void);
+#endif
         DieIdRegister readDieId(void);
+        Reading<DieIdRegister> tryReadDieId(void);
+};
+
+/*!
+ *  @brief Collects ConfigurationRegister field changes and applies them
+ *  in a single write, so a full reconfiguration halts the conversion in
+ *  progress only once.
+ *
+ *  Obtain one from INA260Device::configure(), chain the setters and
+ *  finish with commit():
+ *
+ *      ina260.configure()
+ *          .mode(MODE_CONT_ISH_VBUS)
+ *          .averagingCount(AVG_64)
+ *          .currentConversionTime(TIME_1_1_ms)
+ *          .voltageConversionTime(TIME_1_1_ms)
+ *          .commit();
+*/
+template <class Transport>
+class INA260Configuration {
+    private:
+        INA260Device<Transport> *device;
+        ConfigurationRegister reg;
+
+    public:
+        INA260Configuration(INA260Device<Transport> &device, ConfigurationRegister base);
+
+        INA260Configuration &mode(Mode mode);
+        INA260Configuration &averagingCount(AveragingCount count);
+        INA260Configuration &currentConversionTime(ConversionTime time);
+        INA260Configuration &voltageConversionTime(ConversionTime time);
+
+        ConfigurationRegister value(void) const;
+        bool commit(void);
 };
 
+#include "INA260.tpp"
+
+#ifdef ARDUINO
+    #include "WireTransport.h"
+
+    // The classic Arduino driver: INA260 talking to the global Wire bus.
+    typedef INA260Device<WireTransport> INA260;
+#endif
+
 #endif // INA260.H
 
@@ -0,0 +1,1232 @@
+/*!
+ *    @brief  Instantiates a new INA260 class on the transport's
+ *    default bus (the global Wire object for WireTransport).
+ */
+template <class Transport>
+INA260Device<Transport>::INA260Device(void) :
+    bus(&Transport::defaultInstance()),
+    address(INA260_I2CADDR_DEFAULT),
+    pointerCache(true),
+    shadowRegisters(false),
+    shadowValid(false),
+    shadowConfig(),
+    shadowMaskEnable(),
+    lastStatus(STATUS_OK),
+    deviceCount(0) {}
+
+/*!
+ *    @brief  Instantiates a new INA260 class on the given bus.
+ *
+ *    @param bus The transport the device is connected to.
+ *    @param addr The device address.
+ */
+template <class Transport>
+INA260Device<Transport>::INA260Device(Transport &bus, uint8_t addr) :
+    bus(&bus),
+    address(addr),
+    pointerCache(true),
+    shadowRegisters(false),
+    shadowValid(false),
+    shadowConfig(),
+    shadowMaskEnable(),
+    lastStatus(STATUS_OK),
+    deviceCount(0) {}
+
+/*!
+ *    @brief  Sets up the HW
+ * 
+ *    @return True if initialization was successful, otherwise false.
+ */
+template <class Transport>
+bool INA260Device<Transport>::begin() {
+    INA260_STATS_API(API_BEGIN);
+    if (! bus->begin()) {
+        return false;
+    }
+    reset();
+    return true;
+}
+
+/*!
+ *  @brief Resets the hardware. All registers are set to default values,
+ *  the same as a power-on reset.
+ *
+ *  @return True if reset was successfull, otherwise false.
+*/
+template <class Transport>
+bool INA260Device<Transport>::reset(void) {
+    INA260_STATS_API(API_RESET);
+    ConfigurationRegister reg{};
+    reg.rst = 1;
+    return writeConfigurationRegister(reg);
+}
+
+/*!
+ *  @brief Sets a device address.
+*/
+template <class Transport>
+void INA260Device<Transport>::setAddress(uint8_t addr) {
+    address = addr;
+    shadowValid = false;
+}
+
+/*!
+ *  @brief Gets the device address.
+ *
+ *  @return The currently set device address.
+*/
+template <class Transport>
+uint8_t INA260Device<Transport>::getAddress(void) {
+    return address;
+}
+
+/*!
+ *  @brief Gets the transport the device is connected to.
+ *
+ *  @return The bus transport.
+*/
+template <class Transport>
+Transport &INA260Device<Transport>::transport(void) {
+    return *bus;
+}
+
+/*!
+ *  @brief Enables or disables register pointer caching (enabled by
+ *  default). The INA260 keeps its register pointer between
+ *  transactions, so a read of the same register as the previous
+ *  transfer to the device skips the pointer write and costs a single
+ *  2-byte read. The transport tracks the pointer per address, so other
+ *  objects and scans on the same transport are accounted for.
+ *
+ *  @param enabled True to cache the pointer, false to always send it.
+ *
+ *  @note Disable caching if anything that bypasses the transport (another
+ *  master, or code using the bus directly) may move the pointer.
+*/
+template <class Transport>
+void INA260Device<Transport>::setPointerCache(bool enabled) {
+    pointerCache = enabled;
+}
+
+/*!
+ *  @brief Forgets the device's register pointer, so the next read sends
+ *  it. Call this after something that bypasses the transport has moved
+ *  the pointer.
+*/
+template <class Transport>
+void INA260Device<Transport>::invalidatePointerCache(void) {
+    bus->pointers().invalidate(address);
+}
+
+/*!
+ *  @brief Is register pointer caching enabled.
+ *
+ *  @return True if enabled, otherwise false.
+*/
+template <class Transport>
+bool INA260Device<Transport>::isPointerCacheEnabled(void) {
+    return pointerCache;
+}
+
+/*!
+ *  @brief Enables or disables the shadow copies of the
+ *  ConfigurationRegister and the writable bits of the MaskEnableRegister
+ *  (disabled by default). While enabled, configuration getters are
+ *  answered without bus traffic and setters cost a single write.
+ *
+ *  @param enabled True to keep shadow copies, false to always use the bus.
+ *  @return True if the shadow copies were loaded (or disabled), otherwise
+ *  false.
+ *
+ *  @note The shadow copies only track changes made through this object.
+ *  Call resync() after anything else resets or reconfigures the device.
+*/
+template <class Transport>
+bool INA260Device<Transport>::setShadowRegisters(bool enabled) {
+    shadowRegisters = enabled;
+    shadowValid = false;
+    return enabled ? resync() : true;
+}
+
+/*!
+ *  @brief Are the shadow registers enabled.
+ *
+ *  @return True if enabled, otherwise false.
+*/
+template <class Transport>
+bool INA260Device<Transport>::isShadowRegistersEnabled(void) {
+    return shadowRegisters;
+}
+
+/*!
+ *  @brief Reloads the shadow registers from the hardware.
+ *
+ *  @return True if both registers were read, otherwise false.
+ *
+ *  @note Reading the MaskEnableRegister clears the Conversion Ready
+ *  and (when latched) the Alert Function flags.
+*/
+template <class Transport>
+bool INA260Device<Transport>::resync(void) {
+    INA260_STATS_API(API_RESYNC);
+    shadowValid = false;
+    uint16_t config;
+    uint16_t maskEnable;
+    if (! readRegister(INA260_CONFIG_REGISTER, config) ||
+        ! readRegister(INA260_MASK_ENABLE_REGISTER, maskEnable)) {
+        return false;
+    }
+    shadowConfig.rawValue = config;
+    shadowConfig.rst = 0;
+    shadowMaskEnable.rawValue = maskEnable & INA260_MASK_ENABLE_WRITABLE;
+    shadowValid = true;
+    return true;
+}
+
+/*!
+ *  @brief Gets the writable MaskEnableRegister bits, from the shadow
+ *  copy when enabled and otherwise from the device.
+ *
+ *  @return The MaskEnableRegister settings.
+*/
+template <class Transport>
+Reading<MaskEnableRegister> INA260Device<Transport>::maskEnableSettings(void) {
+    if (shadowRegisters && (shadowValid || resync())) {
+        return Reading<MaskEnableRegister>{ shadowMaskEnable, STATUS_OK };
+    }
+    return tryReadMaskEnableRegister();
+}
+
+/*!
+ *  @brief Gets the status of the last register read or write, so the
+ *  plain read functions can be checked after the fact.
+ *
+ *  @return The status of the last transaction.
+*/
+template <class Transport>
+Status INA260Device<Transport>::getLastStatus(void) {
+    return lastStatus;
+}
+
+/*!
+ *  @brief Reads the specified INA260 register. The pointer write is
+ *  skipped when the pointer cache says the device already points at reg.
+ * 
+ *  @param reg The register to read.
+ * 
+ *  @return The value of the register.
+*/
+template <class Transport>
+uint16_t INA260Device<Transport>::readRegister(uint8_t reg) {
+    uint16_t value = 0;
+    readRegister(reg, value);
+    return value;
+}
+
+/*!
+ *  @brief Reads the specified INA260 register, reporting failures.
+ *  The pointer write is skipped when the pointer cache says the device
+ *  already points at reg.
+ *
+ *  @param reg The register to read.
+ *  @param value Receives the value of the register, untouched on failure.
+ *
+ *  @return True if read was successfull, otherwise false.
+*/
+template <class Transport>
+bool INA260Device<Transport>::readRegister(uint8_t reg, uint16_t &value) {
+    uint8_t data[2];
+    bool ok;
+    INA260_STATS_START();
+    const bool cached = pointerCache && bus->pointers().get(address) == reg;
+    if (cached) {
+        ok = bus->read(address, data, 2);
+    } else {
+        ok = bus->writeRead(address, &reg, 1, data, 2);
+    }
+    INA260_STATS_RECORD(reg, false, cached, ok);
+    if (ok) {
+        lastStatus = STATUS_OK;
+        const uint16_t msb = data[0];
+        const uint16_t lsb = data[1];
+        value = (msb << 8) | lsb;
+        return true;
+    }
+    lastStatus = STATUS_READ_FAILED;
+    return false;
+}
+
+/*!
+ *  @brief Reads the specified INA260 register, reporting failures.
+ *
+ *  @param reg The register to read.
+ *
+ *  @return The value of the register and the transaction status.
+*/
+template <class Transport>
+Reading<uint16_t> INA260Device<Transport>::tryReadRegister(uint8_t reg) {
+    Reading<uint16_t> result = { 0, STATUS_OK };
+    if (! readRegister(reg, result.value)) {
+        result.status = STATUS_READ_FAILED;
+    }
+    return result;
+}
+
+/*!
+ *  @brief Reads the specified INA260 register.
+ * 
+ *  @param reg The register to read.
+ *  @param value the value to write to the register.
+ * 
+ *  @return True if write was successfull, otherwise false.
+*/
+template <class Transport>
+bool INA260Device<Transport>::writeRegister(uint8_t reg, uint16_t value) {
+    const uint8_t data[3] = {
+        reg,
+        static_cast<uint8_t>((value >> 8) & 0xFF),
+        static_cast<uint8_t>(value & 0xFF)
+    };
+    INA260_STATS_START();
+    const bool ok = bus->write(address, data, 3);
+    INA260_STATS_RECORD(reg, true, false, ok);
+    lastStatus = ok ? STATUS_OK : STATUS_WRITE_FAILED;
+    return ok;
+}
+
+/*!
+ *  @brief Reads the current configuration from the 
+ *  ConfigurationRegister.
+ * 
+ *  @return The rawValue from the register.
+ * 
+ *  @note Reading from the ConfigurationRegister will not
+ *  impact current conversions in progress. With shadow registers
+ *  enabled the shadow copy is returned without bus traffic.
+*/
+template <class Transport>
+ConfigurationRegister INA260Device<Transport>::readConfigurationRegister(void) {
+    INA260_STATS_API(API_READ_CONFIGURATION);
+    return tryReadConfigurationRegister().value;
+}
+
+/*!
+ *  @brief Reads the current configuration from the
+ *  ConfigurationRegister, reporting failures.
+ *
+ *  @return The register and the transaction status.
+*/
+template <class Transport>
+Reading<ConfigurationRegister> INA260Device<Transport>::tryReadConfigurationRegister(void) {
+    INA260_STATS_API(API_READ_CONFIGURATION);
+    Reading<ConfigurationRegister> result = { {}, STATUS_OK };
+    if (shadowRegisters && (shadowValid || resync())) {
+        result.value = shadowConfig;
+    } else if (! readRegister(INA260_CONFIG_REGISTER, result.value.rawValue)) {
+        result.status = STATUS_READ_FAILED;
+    }
+    return result;
+}
+
+/*!
+ *  @brief Writes a ConfigurationRegister to the register. 
+ *  
+ *  @return True if write was successfull, otherwise false.
+ * 
+ *  @note Writing to the ConfigurationRegister halts any 
+ *  conversion in progress until the write sequence is completed
+*/
+template <class Transport>
+bool INA260Device<Transport>::writeConfigurationRegister(ConfigurationRegister value) {
+    INA260_STATS_API(API_WRITE_CONFIGURATION);
+    const bool ok = writeRegister(INA260_CONFIG_REGISTER, value.rawValue);
+    if (! ok) {
+        shadowValid = false;
+    } else if (value.rst) {
+        shadowConfig.rawValue = INA260_CONFIG_DEFAULT;
+        shadowMaskEnable.rawValue = 0;
+    } else {
+        shadowConfig = value;
+    }
+    return ok;
+}
+
+/*!
+ *  @brief Starts a configuration change based on the current settings.
+ *  Costs one register read, or none with shadow registers enabled.
+ *
+ *  @return A builder whose commit() writes all changes at once.
+*/
+template <class Transport>
+INA260Configuration<Transport> INA260Device<Transport>::configure(void) {
+    INA260_STATS_API(API_CONFIGURE);
+    return INA260Configuration<Transport>(*this, readConfigurationRegister());
+}
+
+/*!
+ *  @brief Starts a configuration change based on the power-on defaults,
+ *  without reading the device.
+ *
+ *  @return A builder whose commit() writes all changes at once.
+*/
+template <class Transport>
+INA260Configuration<Transport> INA260Device<Transport>::configureDefaults(void) {
+    ConfigurationRegister reg{};
+    reg.rawValue = INA260_CONFIG_DEFAULT;
+    return INA260Configuration<Transport>(*this, reg);
+}
+
+/*!
+ *  @brief Reads and scales the current value of the Current register.
+ *  
+ *  @return The current current measurement in mA, negative for reverse
+ *  current.
+*/
+template <class Transport>
+float INA260Device<Transport>::readCurrent(void) {
+    INA260_STATS_API(API_READ_CURRENT);
+    return tryReadCurrent().value;
+}
+
+/*!
+ *  @brief Reads and scales the current value of the Bus Voltage register.
+ *  
+ *  @return The current bus voltage measurement in mV.
+*/
+template <class Transport>
+float INA260Device<Transport>::readBusVoltage(void) {
+    INA260_STATS_API(API_READ_BUS_VOLTAGE);
+    return tryReadBusVoltage().value;
+}
+
+/*!
+ *  @brief Reads and scales the current value of the Power register.
+ *  
+ *  @return The current Power calculation in mW.
+*/
+template <class Transport>
+float INA260Device<Transport>::readPower(void) {
+    INA260_STATS_API(API_READ_POWER);
+    return tryReadPower().value;
+}
+
+/*!
+ *  @brief Reads and scales the Current register, reporting failures.
+ *
+ *  @return The current measurement in mA and the transaction status.
+*/
+template <class Transport>
+Reading<float> INA260Device<Transport>::tryReadCurrent(void) {
+    INA260_STATS_API(API_READ_CURRENT);
+    const Reading<uint16_t> raw = tryReadRegister(INA260_CURRENT_REGISTER);
+    return Reading<float>{ static_cast<int16_t>(raw.value) * 1.25f, raw.status };
+}
+
+/*!
+ *  @brief Reads and scales the Bus Voltage register, reporting failures.
+ *
+ *  @return The bus voltage measurement in mV and the transaction status.
+*/
+template <class Transport>
+Reading<float> INA260Device<Transport>::tryReadBusVoltage(void) {
+    INA260_STATS_API(API_READ_BUS_VOLTAGE);
+    const Reading<uint16_t> raw = tryReadRegister(INA260_VOLTAGE_REGISTER);
+    return Reading<float>{ raw.value * 1.25f, raw.status };
+}
+
+/*!
+ *  @brief Reads and scales the Power register, reporting failures.
+ *
+ *  @return The power calculation in mW and the transaction status.
+*/
+template <class Transport>
+Reading<float> INA260Device<Transport>::tryReadPower(void) {
+    INA260_STATS_API(API_READ_POWER);
+    const Reading<uint16_t> raw = tryReadRegister(INA260_POWER_REGISTER);
+    return Reading<float>{ raw.value * 10.0f, raw.status };
+}
+
+/*!
+ *  @brief Reads the Current register using integer arithmetic only.
+ *
+ *  @return The signed current measurement in uA, 0 if the read failed
+ *  (see getLastStatus()).
+*/
+template <class Transport>
+int32_t INA260Device<Transport>::readCurrentMicroAmps(void) {
+    INA260_STATS_API(API_READ_CURRENT);
+    return currentMicroAmps(readRegister(INA260_CURRENT_REGISTER));
+}
+
+/*!
+ *  @brief Reads the Bus Voltage register using integer arithmetic only.
+ *
+ *  @return The bus voltage measurement in uV, 0 if the read failed
+ *  (see getLastStatus()).
+*/
+template <class Transport>
+uint32_t INA260Device<Transport>::readBusVoltageMicroVolts(void) {
+    INA260_STATS_API(API_READ_BUS_VOLTAGE);
+    return busVoltageMicroVolts(readRegister(INA260_VOLTAGE_REGISTER));
+}
+
+/*!
+ *  @brief Reads the Power register using integer arithmetic only.
+ *
+ *  @return The power calculation in uW, 0 if the read failed
+ *  (see getLastStatus()).
+*/
+template <class Transport>
+uint32_t INA260Device<Transport>::readPowerMicroWatts(void) {
+    INA260_STATS_API(API_READ_POWER);
+    return powerMicroWatts(readRegister(INA260_POWER_REGISTER));
+}
+
+/*!
+ *  @brief Reads current, bus voltage, power and the MaskEnableRegister
+ *  flags in one tight sequence of four register reads, without scaling.
+ *
+ *  With sameConversion set, the reads are bracketed by a second read of
+ *  the MaskEnableRegister: if the Conversion Ready Flag was raised again
+ *  while the values were being read, a conversion finished mid-sequence
+ *  and the sequence is repeated, up to INA260_SNAPSHOT_ATTEMPTS times.
+ *
+ *  @param snapshot Receives the values. flags holds the MaskEnableRegister
+ *  read before the values, plus any flags a retried attempt cleared, so
+ *  flags.cvrf reports whether they are new.
+ *  @param sameConversion True to guarantee all values come from the same
+ *  conversion.
+ *  @return True if all values were read (and, with sameConversion, come
+ *  from the same conversion), otherwise false.
+ *
+ *  @note Reading the MaskEnableRegister clears the Conversion Ready Flag
+ *  and, when latched, the Alert Function Flag.
+*/
+template <class Transport>
+bool INA260Device<Transport>::readSnapshot(Snapshot &snapshot, bool sameConversion) {
+    INA260_STATS_API(API_READ_SNAPSHOT);
+    MaskEnableRegister carried{}; // Flags cleared by the bracketing read of a retried attempt
+    for (uint8_t attempt = 0; attempt < INA260_SNAPSHOT_ATTEMPTS; attempt++) {
+        if (! readRegister(INA260_MASK_ENABLE_REGISTER, snapshot.flags.rawValue) ||
+            ! readRegister(INA260_CURRENT_REGISTER, snapshot.current) ||
+            ! readRegister(INA260_VOLTAGE_REGISTER, snapshot.voltage) ||
+            ! readRegister(INA260_POWER_REGISTER, snapshot.power)) {
+            return false;
+        }
+        snapshot.flags.cvrf |= carried.cvrf;
+        snapshot.flags.ovf |= carried.ovf;
+        snapshot.flags.aff |= carried.aff;
+        if (! sameConversion) {
+            return true;
+        }
+        MaskEnableRegister after{};
+        if (! readRegister(INA260_MASK_ENABLE_REGISTER, after.rawValue)) {
+            return false;
+        }
+        snapshot.flags.ovf |= after.ovf;
+        snapshot.flags.aff |= after.aff;
+        if (! after.cvrf) {
+            return true;
+        }
+        // The retry reads values from the conversion that raised the
+        // flag, so they are new even though the next read finds it clear.
+        carried.cvrf = 1;
+        carried.ovf |= after.ovf;
+        carried.aff |= after.aff;
+    }
+    return false;
+}
+
+/*!
+ *  @brief Takes one triggered measurement. Writes the configuration to
+ *  trigger a conversion, sleeps for the time the configured conversion
+ *  times and averaging count take, then confirms the Conversion Ready
+ *  Flag with a single read before reading the results. With shadow
+ *  registers enabled this is one write and four reads, instead of
+ *  polling isConversionRready() for the whole conversion.
+ *
+ *  @param snapshot Receives the values.
+ *  @param sleep How to wait for the conversion.
+ *  @return True if a conversion completed and was read, false if the
+ *  device is not in a triggered mode or a transaction failed.
+ *
+ *  @note In MODE_TRIG_ISH or MODE_TRIG_VBUS only the measured quantity
+ *  (and power) is updated.
+*/
+template <class Transport>
+bool INA260Device<Transport>::measureOnce(Snapshot &snapshot, INA260SleepFunction sleep) {
+    INA260_STATS_API(API_MEASURE_ONCE);
+    const Reading<ConfigurationRegister> config = tryReadConfigurationRegister();
+    if (! config.ok() || config.value.mode < MODE_TRIG_ISH || config.value.mode > MODE_TRIG_ISH_VBUS) {
+        return false;
+    }
+    if (! writeConfigurationRegister(config.value)) {
+        return false;
+    }
+    // The conversion clock is internal; allow for it running slow.
+    const uint32_t period = conversionPeriodMicros(config.value);
+    sleep(period + period / 16);
+    for (uint8_t attempt = 0; attempt < INA260_TRIGGER_ATTEMPTS; attempt++) {
+        if (! readRegister(INA260_MASK_ENABLE_REGISTER, snapshot.flags.rawValue)) {
+            return false;
+        }
+        if (snapshot.flags.cvrf) {
+            return readRegister(INA260_CURRENT_REGISTER, snapshot.current) &&
+                   readRegister(INA260_VOLTAGE_REGISTER, snapshot.voltage) &&
+                   readRegister(INA260_POWER_REGISTER, snapshot.power);
+        }
+        sleep(period / 16 + 1);
+    }
+    return false;
+}
+
+/*!
+ *  @brief Reads the current configuration from the 
+ *  MaskEnableRegister.
+ * 
+ *  @return The rawValue from the register.
+*/
+template <class Transport>
+MaskEnableRegister INA260Device<Transport>::readMaskEnableRegister(void) {
+    INA260_STATS_API(API_READ_MASK_ENABLE);
+    return tryReadMaskEnableRegister().value;
+}
+
+/*!
+ *  @brief Reads the current configuration from the
+ *  MaskEnableRegister, reporting failures.
+ *
+ *  @return The register and the transaction status.
+*/
+template <class Transport>
+Reading<MaskEnableRegister> INA260Device<Transport>::tryReadMaskEnableRegister(void) {
+    INA260_STATS_API(API_READ_MASK_ENABLE);
+    Reading<MaskEnableRegister> result = { {}, STATUS_OK };
+    if (! readRegister(INA260_MASK_ENABLE_REGISTER, result.value.rawValue)) {
+        result.status = STATUS_READ_FAILED;
+    } else if (shadowValid) {
+        shadowMaskEnable.rawValue = result.value.rawValue & INA260_MASK_ENABLE_WRITABLE;
+    }
+    return result;
+}
+
+/*!
+ *  @brief Writes a MaskEnableRegister to the register. 
+ * 
+ *  @return True if write was successfull, otherwise false.
+*/
+template <class Transport>
+bool INA260Device<Transport>::writeMaskEnableRegister(MaskEnableRegister reg) {
+    INA260_STATS_API(API_WRITE_MASK_ENABLE);
+    const bool ok = writeRegister(INA260_MASK_ENABLE_REGISTER, reg.rawValue);
+    if (ok) {
+        shadowMaskEnable.rawValue = reg.rawValue & INA260_MASK_ENABLE_WRITABLE;
+    } else {
+        shadowValid = false;
+    }
+    return ok;
+}
+
+/*!
+ *  @brief Reads the current value of the alert limit register. 
+ * 
+ *  @return a value based on which limit register is set.
+*/
+template <class Transport>
+double INA260Device<Transport>::readAlertLimitRegister(void) {
+    INA260_STATS_API(API_READ_ALERT_LIMIT);
+    return tryReadAlertLimitRegister().value;
+}
+
+/*!
+ *  @brief Reads the current value of the alert limit register,
+ *  reporting failures.
+ *
+ *  @return a value based on which limit register is set, and the
+ *  transaction status.
+*/
+template <class Transport>
+Reading<double> INA260Device<Transport>::tryReadAlertLimitRegister(void) {
+    INA260_STATS_API(API_READ_ALERT_LIMIT);
+    const Reading<MaskEnableRegister> reg = maskEnableSettings();
+    if (! reg.ok()) {
+        return Reading<double>{ 0.0, reg.status };
+    }
+    const Reading<uint16_t> raw = tryReadRegister(INA260_ALERT_LIMIT_REGISTER);
+    if (reg.value.pol == 1) {
+        return Reading<double>{ raw.value * 10.0, raw.status };
+    }
+    return Reading<double>{ raw.value * 1.25, raw.status };
+}
+
+/*!
+ *  @brief Writes the Alert Limit Register value.
+ * 
+ *  @param value the raw value to write.
+ *  @return True if write was successfull, otherwise false.
+*/
+template <class Transport>
+bool INA260Device<Transport>::writeAlertLimitRegister(uint16_t value) {
+    INA260_STATS_API(API_WRITE_ALERT_LIMIT);
+    return writeRegister(INA260_ALERT_LIMIT_REGISTER, value);
+}
+
+/*!
+ *  @brief Configures the device to pull the ALERT pin low when the 
+ *  shunt current exceeds the value given. Clears all other limit alerts.
+ * 
+ *  @param milliAmps value to set in milliAmps.
+ *  @return True if write was successfull, otherwise false.
+*/
+template <class Transport>
+bool INA260Device<Transport>::enableOverCurrentLimitAlert(uint16_t milliAmps) {
+    INA260_STATS_API(API_ENABLE_OVER_CURRENT_ALERT);
+    MaskEnableRegister reg = maskEnableSettings().value;
+    reg.ocl = 1;
+    reg.ucl = 0;
+    reg.bol = 0;
+    reg.bul = 0;
+    reg.pol = 0;
+    setCurrentLimit(milliAmps);
+    return writeMaskEnableRegister(reg);
+}
+
+/*!
+ *  @brief Configures the device to pull the ALERT pin low when the 
+ *  shunt current drops below the value given. Clears all other limit alerts.
+ * 
+ *  @param milliAmps value to set in milliAmps.
+ *  @return True if write was successfull, otherwise false.
+*/
+template <class Transport>
+bool INA260Device<Transport>::enableUnderCurrentLimitAlert(uint16_t milliAmps) {
+    INA260_STATS_API(API_ENABLE_UNDER_CURRENT_ALERT);
+    MaskEnableRegister reg = maskEnableSettings().value;
+    reg.ocl = 0;
+    reg.ucl = 1;
+    reg.bol = 0;
+    reg.bul = 0;
+    reg.pol = 0;
+    setCurrentLimit(milliAmps);
+    return writeMaskEnableRegister(reg);
+}
+
+/*!
+ *  @brief Configures the device to pull the ALERT pin low when the 
+ *  bus voltage exceeds the value given. Clears all other limit alerts.
+ * 
+ *  @param milliVolts value to set in milliVolts.
+ *  @return True if write was successfull, otherwise false.
+*/
+template <class Transport>
+bool INA260Device<Transport>::enableBusOvertLimitAlert(uint16_t milliVolts) {
+    INA260_STATS_API(API_ENABLE_BUS_OVER_ALERT);
+    MaskEnableRegister reg = maskEnableSettings().value;
+    reg.ocl = 0;
+    reg.ucl = 0;
+    reg.bol = 1;
+    reg.bul = 0;
+    reg.pol = 0;
+    setBusVoltageLimit(milliVolts);
+    return writeMaskEnableRegister(reg);
+}
+
+/*!
+ *  @brief Configures the device to pull the ALERT pin low when the 
+ *  bus voltage drops below the value given. Clears all other limit alerts.
+ * 
+ *  @param milliVolts value to set in milliVolts.
+ *  @return True if write was successfull, otherwise false.
+*/
+template <class Transport>
+bool INA260Device<Transport>::enableBusUnderLimitAlert(uint16_t milliVolts) {
+    INA260_STATS_API(API_ENABLE_BUS_UNDER_ALERT);
+    MaskEnableRegister reg = maskEnableSettings().value;
+    reg.ocl = 0;
+    reg.ucl = 0;
+    reg.bol = 0;
+    reg.bul = 1;
+    reg.pol = 0;
+    setBusVoltageLimit(milliVolts);
+    return writeMaskEnableRegister(reg);
+}
+
+/*!
+ *  @brief Configures the device to pull the ALERT pin low when the 
+ *  power excceeds the value given. Clears all other limit alerts.
+ * 
+ *  @param milliWatts value to set in milliWatts.
+ *  @return True if write was successfull, otherwise false.
+*/
+template <class Transport>
+bool INA260Device<Transport>::enableOverPowerLimitAlert(uint16_t milliWatts) {
+    INA260_STATS_API(API_ENABLE_OVER_POWER_ALERT);
+    MaskEnableRegister reg = maskEnableSettings().value;
+    reg.ocl = 0;
+    reg.ucl = 0;
+    reg.bol = 0;
+    reg.bul = 0;
+    reg.pol = 1;
+    setPowerLimit(milliWatts);
+    return writeMaskEnableRegister(reg);
+}
+
+/*!
+ *  @brief Sets the value of the Alert Limit Register to value given.
+ * 
+ *  @param milliAmps value to set in milliAmps.
+ *  @return True if write was successfull, otherwise false.
+*/
+template <class Transport>
+bool INA260Device<Transport>::setCurrentLimit(uint16_t milliAmps) {
+    INA260_STATS_API(API_SET_CURRENT_LIMIT);
+    uint16_t value = (static_cast<uint32_t>(milliAmps) * 4) / 5;
+    return writeAlertLimitRegister(value);
+}
+
+/*!
+ *  @brief Sets the value of the Alert Limit Register to value given.
+ * 
+ *  @param milliVolts value to set in milliVolts.
+ *  @return True if write was successfull, otherwise false.
+*/
+template <class Transport>
+bool INA260Device<Transport>::setBusVoltageLimit(uint16_t milliVolts) {
+    INA260_STATS_API(API_SET_BUS_VOLTAGE_LIMIT);
+    uint16_t value = (static_cast<uint32_t>(milliVolts) * 4) / 5;
+    return writeAlertLimitRegister(value);
+}
+
+/*!
+ *  @brief Sets the value of the Alert Limit Register to value given.
+ * 
+ *  @param milliWatts value to set in milliWatts.
+ *  @return True if write was successfull, otherwise false.
+*/
+template <class Transport>
+bool INA260Device<Transport>::setPowerLimit(uint16_t milliWatts) {
+    INA260_STATS_API(API_SET_POWER_LIMIT);
+    uint16_t value = milliWatts / 10;
+    return writeAlertLimitRegister(value);
+}
+
+/*!
+ *  @brief This bit is set to '1' if an arithmetic operation resulted 
+ *  in an overflow error. It indicates that power data may have exceeded 
+ *  the maximum reportable value of 419.43 W.
+ * 
+ *  @return True if flag is set, otherwise false.
+*/
+template <class Transport>
+bool INA260Device<Transport>::isMathOverFlow(void) {
+    INA260_STATS_API(API_IS_MATH_OVERFLOW);
+    MaskEnableRegister reg = readMaskEnableRegister();
+    return reg.ovf;
+}
+
+/*!
+ *  @brief Is the Alert Function Flag currently set. The Alert Function Flag
+ *  allows the user to determine if the Alert Function was the source of the
+ *  alert.
+ * 
+ *  @return True if flag is set, otherwise false.
+*/
+template <class Transport>
+bool INA260Device<Transport>::isAlert(void) {
+    INA260_STATS_API(API_IS_ALERT);
+    MaskEnableRegister reg = readMaskEnableRegister();
+    return reg.aff;
+}
+
+/*!
+ *  @brief Clears the Alert Function Flag.
+*/
+template <class Transport>
+void INA260Device<Transport>::clearAlert(void) {
+    INA260_STATS_API(API_CLEAR_ALERT);
+    readMaskEnableRegister();
+}
+
+/*!
+ *  @brief Is the Alert Polarity Flag is currently set to inverted.
+ * 
+ *  @return True if flag is set, otherwise false.
+*/
+template <class Transport>
+bool INA260Device<Transport>::isAlertPolaritySet(void) {
+    INA260_STATS_API(API_IS_ALERT_POLARITY_SET);
+    MaskEnableRegister reg = maskEnableSettings().value;
+    return reg.apol;
+}
+
+/*!
+ *  @brief Sets the Alert Polarity Flag.
+ * 
+ *  @param polarity 1 = Inverted, 0 = Normal (default).
+ * 
+ *  @return True if write was successfull, otherwise false.
+*/
+template <class Transport>
+bool INA260Device<Transport>::setAlertPolarity(bool polarity) {
+    INA260_STATS_API(API_SET_ALERT_POLARITY);
+    MaskEnableRegister reg = maskEnableSettings().value;
+    reg.apol = polarity;
+    return writeMaskEnableRegister(reg);
+}
+
+/*!
+ *  @brief Is the Alert Latch Enable currently set to Latch enabled.
+ * 
+ *  @return True if latch is set, otherwise false.
+*/
+template <class Transport>
+bool INA260Device<Transport>::isAlertLatchSet(void) {
+    INA260_STATS_API(API_IS_ALERT_LATCH_SET);
+    MaskEnableRegister reg = maskEnableSettings().value;
+    return reg.len;
+}
+
+/*!
+ *  @brief Sets Alert Latch Enable.
+ * 
+ *  @param latch 1 = Latch enabled, 0 = Transparent (default).
+ * 
+ *  @return True if write was successfull, otherwise false.
+*/
+template <class Transport>
+bool INA260Device<Transport>::setAlertLatch(bool latch) {
+    INA260_STATS_API(API_SET_ALERT_LATCH);
+    MaskEnableRegister reg = maskEnableSettings().value;
+    reg.len = latch;
+    return writeMaskEnableRegister(reg);
+}
+
+/*!
+ *  @brief Returns the current measurement mode
+ * 
+ *  @return Mode that is currently set.
+*/
+template <class Transport>
+Mode INA260Device<Transport>::getMode(void) {
+    INA260_STATS_API(API_GET_MODE);
+    ConfigurationRegister reg = readConfigurationRegister();
+    return (Mode)reg.mode;
+}
+
+/*!
+ *  @brief Sets the operating mode from the list given in enum type "Mode".
+ * 
+ *  @param mode the new mode to set.
+ */
+template <class Transport>
+void INA260Device<Transport>::setMode(Mode mode) {
+    INA260_STATS_API(API_SET_MODE);
+    ConfigurationRegister reg = readConfigurationRegister();
+    reg.mode = mode;
+    writeConfigurationRegister(reg);
+};
+
+/*!
+ *  @brief The Conversion Ready Flag bit is provided to help coordinate 
+ *  one-shot or triggered conversions. 
+ * 
+ *  @return True if conversion is ready, otherwise false.
+*/
+template <class Transport>
+bool INA260Device<Transport>::isConversionRready() {
+    INA260_STATS_API(API_IS_CONVERSION_READY);
+    MaskEnableRegister reg = readMaskEnableRegister();
+    return reg.cvrf;
+}
+
+/*!
+ *  @brief Configures the device to pull the ALERT pin low when a 
+ *  conversion is complete.
+ * 
+ *  @param state sets the alert state true or false (default).
+ *  @return True if write was successfull, otherwise false.
+*/
+template <class Transport>
+bool INA260Device<Transport>::setConversionReadyAlert(bool state) {
+    INA260_STATS_API(API_SET_CONVERSION_READY_ALERT);
+    MaskEnableRegister reg = maskEnableSettings().value;
+    reg.cnvr = state;
+    return writeMaskEnableRegister(reg);
+}
+
+/*!
+ *  @brief Reads the current current conversion time.
+ * 
+ *  @return The current current conversion time.
+*/
+template <class Transport>
+ConversionTime INA260Device<Transport>::getCurrentConversionTime(void) {
+    INA260_STATS_API(API_GET_CURRENT_CONVERSION_TIME);
+    ConfigurationRegister reg = readConfigurationRegister();
+    return (ConversionTime)reg.ishct;
+}
+
+/*!
+ *  @brief Sets the current conversion time.
+ * 
+ *  @param time Sets the current conversion time.
+ *  @return True if write was successfull, otherwise false.
+*/
+template <class Transport>
+bool INA260Device<Transport>::setCurrentConversionTime(ConversionTime time) {
+    INA260_STATS_API(API_SET_CURRENT_CONVERSION_TIME);
+    ConfigurationRegister reg = readConfigurationRegister();
+    reg.ishct = time;
+    return writeConfigurationRegister(reg);
+}
+
+/*!
+ *  @brief Reads the current bus voltage conversion time.
+ * 
+ *  @return The current bus voltage conversion time.
+*/
+template <class Transport>
+ConversionTime INA260Device<Transport>::getVoltageConversionTime(void) {
+    INA260_STATS_API(API_GET_VOLTAGE_CONVERSION_TIME);
+    ConfigurationRegister reg = readConfigurationRegister();
+    return (ConversionTime)reg.vbusct;
+}
+
+/*!
+ *  @brief Sets the bus voltage conversion time.
+ * 
+ *  @param time Sets the bus voltage conversion time.
+ *  @return True if write was successfull, otherwise false.
+*/
+template <class Transport>
+bool INA260Device<Transport>::setVoltageConversionTime(ConversionTime time) {
+    INA260_STATS_API(API_SET_VOLTAGE_CONVERSION_TIME);
+    ConfigurationRegister reg = readConfigurationRegister();
+    reg.vbusct = time;
+    return writeConfigurationRegister(reg);
+}
+
+/*!
+ *  @brief Reads the current number of averaging samples.
+ * 
+ *  @return The current number of averaging samples.
+*/
+template <class Transport>
+AveragingCount INA260Device<Transport>::getAveragingCount(void) {
+    INA260_STATS_API(API_GET_AVERAGING_COUNT);
+    ConfigurationRegister reg = readConfigurationRegister();
+    return (AveragingCount)reg.avg;
+}
+
+/*!
+ *  @brief Sets the number of averaging samples.
+ * 
+ *  @param count The number of samples to be averaged.
+ *  @return True if write was successfull, otherwise false.
+*/
+template <class Transport>
+bool INA260Device<Transport>::setAveragingCount(AveragingCount count) {
+    INA260_STATS_API(API_SET_AVERAGING_COUNT);
+    ConfigurationRegister reg = readConfigurationRegister();
+    reg.avg = count;
+    return writeConfigurationRegister(reg);
+}
+
+/*!
+ *  @brief Reads the Manufacturer ID Register
+ * 
+ *  @return The manufacturers name
+*/
+#ifdef ARDUINO
+template <class Transport>
+String INA260Device<Transport>::readManufactuerId(void) {
+    INA260_STATS_API(API_READ_MANUFACTURER_ID);
+    uint16_t value = readRegister(INA260_MANUFACTURER_ID_REGISTER);
+    char mfgStr[3];
+    mfgStr[0] = static_cast<char>((value >> 8) & 0xFF);
+    mfgStr[1] = static_cast<char>(value & 0xFF);
+    mfgStr[2] = '\0';
+    return mfgStr;
+}
+#endif
+
+/*!
+ *  @brief Reads the Die ID Register
+ * 
+ *  @return DieIdRegister with a unique id number and revision id for the die
+*/
+template <class Transport>
+DieIdRegister INA260Device<Transport>::readDieId(void) {
+    INA260_STATS_API(API_READ_DIE_ID);
+    return tryReadDieId().value;
+}
+
+/*!
+ *  @brief Reads the Die ID Register, reporting failures.
+ *
+ *  @return DieIdRegister and the transaction status.
+*/
+template <class Transport>
+Reading<DieIdRegister> INA260Device<Transport>::tryReadDieId(void) {
+    INA260_STATS_API(API_READ_DIE_ID);
+    Reading<DieIdRegister> result = { {}, STATUS_OK };
+    if (! readRegister(INA260_DIE_ID_REGISTER, result.value.rawValue)) {
+        result.status = STATUS_READ_FAILED;
+    }
+    return result;
+}
+
+/*!
+ *  @brief Scan the whole bus for connected devices. The address of any
+ *  device that acknowledges is stored in devices[] and deviceCount is
+ *  set to the number found, at most the size of devices[].
+ *
+ *  @note Any device on the bus is reported. Use scanDevices() to find
+ *  only INA260s.
+*/
+template <class Transport>
+void INA260Device<Transport>::findDevices() {
+    INA260_STATS_API(API_FIND_DEVICES);
+    const int capacity = sizeof(devices) / sizeof(devices[0]);
+    deviceCount = 0;
+    for (uint8_t address = 1; address < 127 && deviceCount < capacity; address++) {
+        // Use the transport's probe to see if a device did
+        // acknowledge the address then add it to devices[]
+        INA260_STATS_PROBE();
+        if (bus->probe(address)) {
+            devices[deviceCount] = address;
+            deviceCount++;
+        }
+    }    
+}
+
+/*!
+ *  @brief Scan the INA260 address range (ADDRESS_0x40 to ADDRESS_0x4F)
+ *  for INA260s. Each device that acknowledges is confirmed by its
+ *  Manufacturer ID ("TI") and Die ID before being reported, so 16 probes
+ *  plus two reads per hit replace a full bus scan.
+ *
+ *  @param addresses Buffer receiving the addresses of the INA260s found.
+ *  @param capacity Size of the buffer; the scan stops when it is full.
+ *  @return The number of devices found, probed and rejected, and the
+ *  time the scan took.
+*/
+template <class Transport>
+ScanResult INA260Device<Transport>::scanDevices(uint8_t *addresses, uint8_t capacity) {
+    INA260_STATS_API(API_SCAN_DEVICES);
+    ScanResult result = {};
+    const uint32_t start = ina260Micros();
+    for (uint8_t candidate = ADDRESS_0x40; candidate <= ADDRESS_0x4F && result.found < capacity; candidate++) {
+        result.probes++;
+        INA260_STATS_PROBE();
+        if (! bus->probe(candidate)) {
+            continue;
+        }
+        // Read the ID registers of the candidate directly, leaving the
+        // configured address and its shadow copies alone.
+        uint8_t reg = INA260_MANUFACTURER_ID_REGISTER;
+        uint8_t mfg[2] = {};
+        uint8_t die[2] = {};
+        INA260_STATS_START();
+        bool ok = bus->writeRead(candidate, &reg, 1, mfg, 2);
+        INA260_STATS_RECORD(reg, false, false, ok);
+        if (ok) {
+            reg = INA260_DIE_ID_REGISTER;
+            ok = bus->writeRead(candidate, &reg, 1, die, 2);
+            INA260_STATS_RECORD(reg, false, false, ok);
+        }
+        DieIdRegister dieId{};
+        dieId.rawValue = (static_cast<uint16_t>(die[0]) << 8) | die[1];
+        if (ok &&
+            ((static_cast<uint16_t>(mfg[0]) << 8) | mfg[1]) == INA260_MANUFACTURER_ID &&
+            dieId.did == INA260_DIE_ID) {
+            addresses[result.found++] = candidate;
+        } else {
+            result.rejected++;
+        }
+    }
+    result.elapsedMicros = ina260Micros() - start;
+    return result;
+}
+
+/*!
+ *  @brief Instantiates a configuration builder.
+ *
+ *  @param device The device commit() writes to.
+ *  @param base The register value the changes are applied to.
+*/
+template <class Transport>
+INA260Configuration<Transport>::INA260Configuration(INA260Device<Transport> &device, ConfigurationRegister base) :
+    device(&device),
+    reg(base) {
+    reg.rst = 0;
+}
+
+/*!
+ *  @brief Sets the operating mode.
+ *
+ *  @param mode the new mode to set.
+ *  @return This builder.
+*/
+template <class Transport>
+INA260Configuration<Transport> &INA260Configuration<Transport>::mode(Mode mode) {
+    reg.mode = mode;
+    return *this;
+}
+
+/*!
+ *  @brief Sets the number of averaging samples.
+ *
+ *  @param count The number of samples to be averaged.
+ *  @return This builder.
+*/
+template <class Transport>
+INA260Configuration<Transport> &INA260Configuration<Transport>::averagingCount(AveragingCount count) {
+    reg.avg = count;
+    return *this;
+}
+
+/*!
+ *  @brief Sets the current conversion time.
+ *
+ *  @param time the new current conversion time.
+ *  @return This builder.
+*/
+template <class Transport>
+INA260Configuration<Transport> &INA260Configuration<Transport>::currentConversionTime(ConversionTime time) {
+    reg.ishct = time;
+    return *this;
+}
+
+/*!
+ *  @brief Sets the bus voltage conversion time.
+ *
+ *  @param time the new bus voltage conversion time.
+ *  @return This builder.
+*/
+template <class Transport>
+INA260Configuration<Transport> &INA260Configuration<Transport>::voltageConversionTime(ConversionTime time) {
+    reg.vbusct = time;
+    return *this;
+}
+
+/*!
+ *  @brief Gets the register value built so far. It can be written to
+ *  other devices with writeConfigurationRegister().
+ *
+ *  @return The ConfigurationRegister value.
+*/
+template <class Transport>
+ConfigurationRegister INA260Configuration<Transport>::value(void) const {
+    return reg;
+}
+
+/*!
+ *  @brief Writes all collected changes in a single register write.
+ *
+ *  @return True if write was successfull, otherwise false.
+*/
+template <class Transport>
+bool INA260Configuration<Transport>::commit(void) {
+    return device->writeConfigurationRegister(reg);
+}
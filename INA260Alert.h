@@ -0,0 +1,231 @@
+#ifndef INA260Alert_h
+#define INA260Alert_h
+
+#include "INA260.h"
+#include "INA260Clock.h"
+
+/*!
+ *  @brief Called by an alert pin source on each ALERT edge.
+ *
+ *  @param context The pointer given to the pin's begin().
+ *  @param micros Time of the edge on the ina260Micros() (or simulated)
+ *  clock.
+*/
+typedef void (*AlertHandler)(void *context, uint32_t micros);
+
+/*!
+ *  @brief Interrupt-to-sample latency of INA260AlertAcquisition.
+*/
+struct AlertLatency {
+    uint32_t minMicros;
+    uint32_t maxMicros;
+    uint64_t totalMicros;
+    uint32_t count;
+};
+
+/*!
+ *  @brief Conversion-ready driven acquisition: the INA260 pulls ALERT when
+ *  a conversion completes and each edge triggers exactly one snapshot
+ *  read, instead of polling isConversionRready() over the bus.
+ *
+ *  The pin source is any class providing
+ *  begin(AlertHandler, void *), end() and service(uint32_t timeoutMicros);
+ *  see ArduinoAlertPin, LinuxGpioAlertPin and SimulatedAlertPin. The
+ *  handler may run in interrupt context; it only records the edge, and
+ *  the bus is read from poll().
+ *
+ *  ALERT stays asserted until the snapshot read releases it, so
+ *  conversions that finish in the meantime produce no edge of their
+ *  own. They are counted as missed from the time between sampled edges
+ *  and the conversion period read in begin(); call begin() again after
+ *  changing the conversion times, averaging or mode.
+*/
+template <class Transport, class Pin>
+class INA260AlertAcquisition {
+    public:
+        INA260AlertAcquisition(INA260Device<Transport> &device, Pin &pin,
+                               INA260ClockFunction clock = ina260Micros);
+
+        bool begin(void);
+        void end(void);
+
+        bool poll(Snapshot &snapshot, uint32_t timeoutMicros = 0);
+
+        uint32_t getSampleCount(void) const;
+        uint32_t getMissedCount(void) const;
+        const AlertLatency &getLatency(void) const;
+
+    private:
+        INA260Device<Transport> *device;
+        Pin *pin;
+        INA260ClockFunction clock;
+        volatile uint8_t edges;      // Written by the handler only
+        volatile uint32_t edgeMicros; // Written by the handler only
+        uint8_t handled;
+        uint32_t period;             // Conversion period in microseconds
+        uint32_t lastEdge;           // Edge of the latest sample
+        bool hasLastEdge;            // lastEdge is set since begin()
+        uint32_t samples;
+        uint32_t missed;
+        AlertLatency latency;
+
+        static void onEdge(void *context, uint32_t micros);
+};
+
+/*!
+ *  @brief Instantiates an acquisition for one device and its ALERT pin.
+ *
+ *  @param device The device to read.
+ *  @param pin The source of ALERT edges.
+ *  @param clock The clock used to timestamp the end of each read; it
+ *  must match the clock of the pin's edge timestamps.
+*/
+template <class Transport, class Pin>
+INA260AlertAcquisition<Transport, Pin>::INA260AlertAcquisition(INA260Device<Transport> &device, Pin &pin,
+                                                               INA260ClockFunction clock) :
+    device(&device),
+    pin(&pin),
+    clock(clock),
+    edges(0),
+    edgeMicros(0),
+    handled(0),
+    period(0),
+    lastEdge(0),
+    hasLastEdge(false),
+    samples(0),
+    missed(0),
+    latency() {
+    latency.minMicros = UINT32_MAX;
+}
+
+/*!
+ *  @brief Routes the Conversion Ready Flag to ALERT, reads the conversion
+ *  period and starts listening for edges.
+ *
+ *  @return True if the device and the pin were set up, otherwise false.
+*/
+template <class Transport, class Pin>
+bool INA260AlertAcquisition<Transport, Pin>::begin(void) {
+    if (! device->setConversionReadyAlert(true)) {
+        return false;
+    }
+    const Reading<ConfigurationRegister> config = device->tryReadConfigurationRegister();
+    if (! config.ok()) {
+        return false;
+    }
+    period = conversionPeriodMicros(config.value);
+    hasLastEdge = false;
+    handled = edges;
+    if (! pin->begin(onEdge, this)) {
+        return false;
+    }
+    // Release an ALERT that may already be asserted so the next
+    // conversion produces an edge.
+    return device->tryReadMaskEnableRegister().ok();
+}
+
+/*!
+ *  @brief Stops listening and stops routing conversion ready to ALERT.
+*/
+template <class Transport, class Pin>
+void INA260AlertAcquisition<Transport, Pin>::end(void) {
+    pin->end();
+    device->setConversionReadyAlert(false);
+}
+
+/*!
+ *  @brief Reads the device once if ALERT signalled a new conversion.
+ *  Reading the MaskEnableRegister as part of the snapshot releases ALERT
+ *  for the next conversion.
+ *
+ *  @param snapshot Receives the values when a sample is taken.
+ *  @param timeoutMicros How long the pin may wait for an edge, on pin
+ *  sources that wait (0 to only check).
+ *  @return True if a sample was taken, otherwise false. When the read
+ *  fails the edge stays pending and the next poll() retries it.
+*/
+template <class Transport, class Pin>
+bool INA260AlertAcquisition<Transport, Pin>::poll(Snapshot &snapshot, uint32_t timeoutMicros) {
+    if (edges == handled) {
+        pin->service(timeoutMicros);
+    }
+    // edges and edgeMicros are written by the handler; read them until
+    // no edge arrived in between so a multi-byte read cannot tear.
+    uint8_t seen;
+    uint32_t at;
+    do {
+        seen = edges;
+        at = edgeMicros;
+    } while (seen != edges);
+
+    if (seen == handled) {
+        return false;
+    }
+    if (! device->readSnapshot(snapshot)) {
+        return false;
+    }
+    handled = seen;
+
+    // Conversions between the previous sampled edge and this one.
+    if (hasLastEdge && period > 0) {
+        const uint32_t conversions = (at - lastEdge + period / 2) / period;
+        if (conversions > 1) {
+            missed += conversions - 1;
+        }
+    }
+    lastEdge = at;
+    hasLastEdge = true;
+
+    const uint32_t delay = clock() - at;
+    latency.minMicros = (delay < latency.minMicros) ? delay : latency.minMicros;
+    latency.maxMicros = (delay > latency.maxMicros) ? delay : latency.maxMicros;
+    latency.totalMicros += delay;
+    latency.count++;
+    samples++;
+    return true;
+}
+
+/*!
+ *  @brief Gets the number of samples taken.
+ *
+ *  @return The number of samples.
+*/
+template <class Transport, class Pin>
+uint32_t INA260AlertAcquisition<Transport, Pin>::getSampleCount(void) const {
+    return samples;
+}
+
+/*!
+ *  @brief Gets the number of conversions that were not read because
+ *  ALERT was still asserted for an earlier one, estimated from the time
+ *  between sampled edges. The conversions behind one edge are counted
+ *  when the next edge is sampled.
+ *
+ *  @return The number of missed conversions.
+*/
+template <class Transport, class Pin>
+uint32_t INA260AlertAcquisition<Transport, Pin>::getMissedCount(void) const {
+    return missed;
+}
+
+/*!
+ *  @brief Gets the time from ALERT edge to completed read.
+ *
+ *  @return The latency statistics.
+*/
+template <class Transport, class Pin>
+const AlertLatency &INA260AlertAcquisition<Transport, Pin>::getLatency(void) const {
+    return latency;
+}
+
+/*!
+ *  @brief Records an ALERT edge. Safe to call from an interrupt.
+*/
+template <class Transport, class Pin>
+void INA260AlertAcquisition<Transport, Pin>::onEdge(void *context, uint32_t micros) {
+    INA260AlertAcquisition *self = static_cast<INA260AlertAcquisition *>(context);
+    self->edgeMicros = micros;
+    self->edges = self->edges + 1;
+}
+
+#endif // INA260Alert.H
@@ -0,0 +1,250 @@
+#ifndef INA260Async_h
+#define INA260Async_h
+
+#include "INA260.h"
+#include "TransferState.h"
+
+#define INA260_ASYNC_MAX_REGISTERS      4 // Registers one asynchronous read can cover
+
+typedef enum _asyncState {
+    ASYNC_IDLE   = 0, // Nothing started yet
+    ASYNC_BUSY   = 1, // A read is in progress, keep calling step()
+    ASYNC_DONE   = 2, // All registers were read
+    ASYNC_FAILED = 3, // A register read failed, see result()
+} AsyncState;
+
+/*!
+ *  @brief Non-blocking register reader for one INA260.
+ *
+ *  start() queues up to INA260_ASYNC_MAX_REGISTERS register reads and
+ *  step() advances them one bus transfer at a time without waiting for
+ *  the bus, so readers on different buses and other work can be
+ *  interleaved in one loop. Completion is reported by step()'s return
+ *  value and, if set, by a callback.
+ *
+ *  A transport has one pending transfer and poll() reports it to
+ *  whoever asks, so only one reader per bus may be busy at a time; a
+ *  transport refuses to start a transfer while an earlier one has not
+ *  been polled. The reader shares the device's bus and address but not
+ *  its synchronous calls: do not use the device's read/write functions
+ *  on the same bus while a read is in progress.
+*/
+template <class Transport>
+class INA260AsyncReader {
+    public:
+        typedef void (*Callback)(INA260AsyncReader &reader, void *context);
+
+        explicit INA260AsyncReader(INA260Device<Transport> &device);
+
+        void onComplete(Callback callback, void *context = nullptr);
+
+        bool start(uint8_t reg);
+        bool start(const uint8_t *regs, uint8_t count);
+        bool startSnapshot(void);
+
+        AsyncState step(void);
+        AsyncState getState(void) const;
+
+        Reading<uint16_t> result(uint8_t index = 0) const;
+        bool snapshot(Snapshot &snapshot) const;
+
+    private:
+        INA260Device<Transport> *device;
+        Callback callback;
+        void *context;
+        AsyncState state;
+        uint8_t regs[INA260_ASYNC_MAX_REGISTERS];
+        uint16_t values[INA260_ASYNC_MAX_REGISTERS];
+        uint8_t count;
+        uint8_t index;
+        uint8_t data[2];
+
+        bool startNext(void);
+        AsyncState finish(AsyncState result);
+};
+
+/*!
+ *  @brief Instantiates a reader for a device.
+ *
+ *  @param device The device to read from.
+*/
+template <class Transport>
+INA260AsyncReader<Transport>::INA260AsyncReader(INA260Device<Transport> &device) :
+    device(&device),
+    callback(nullptr),
+    context(nullptr),
+    state(ASYNC_IDLE),
+    regs(),
+    values(),
+    count(0),
+    index(0),
+    data() {}
+
+/*!
+ *  @brief Sets a function called from step() when a read finishes,
+ *  successfully or not.
+ *
+ *  @param callback The function to call, nullptr for none.
+ *  @param context Passed to the callback unchanged.
+*/
+template <class Transport>
+void INA260AsyncReader<Transport>::onComplete(Callback callback, void *context) {
+    this->callback = callback;
+    this->context = context;
+}
+
+/*!
+ *  @brief Starts reading one register.
+ *
+ *  @param reg The register to read.
+ *  @return True if the read was started, false if one is in progress.
+*/
+template <class Transport>
+bool INA260AsyncReader<Transport>::start(uint8_t reg) {
+    return start(&reg, 1);
+}
+
+/*!
+ *  @brief Starts reading a list of registers in order.
+ *
+ *  @param regs The registers to read.
+ *  @param count The number of registers, at most INA260_ASYNC_MAX_REGISTERS.
+ *  @return True if the read was started, otherwise false. If the
+ *  transport refused the first transfer the state becomes ASYNC_FAILED
+ *  without a callback.
+*/
+template <class Transport>
+bool INA260AsyncReader<Transport>::start(const uint8_t *regs, uint8_t count) {
+    if (state == ASYNC_BUSY || count == 0 || count > INA260_ASYNC_MAX_REGISTERS) {
+        return false;
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        this->regs[i] = regs[i];
+        values[i] = 0;
+    }
+    this->count = count;
+    index = 0;
+    if (! startNext()) {
+        state = ASYNC_FAILED;
+        return false;
+    }
+    state = ASYNC_BUSY;
+    return true;
+}
+
+/*!
+ *  @brief Starts reading the MaskEnableRegister, current, bus voltage
+ *  and power registers, in the same order as INA260Device::readSnapshot().
+ *
+ *  @return True if the read was started, otherwise false.
+*/
+template <class Transport>
+bool INA260AsyncReader<Transport>::startSnapshot(void) {
+    static const uint8_t snapshotRegs[4] = {
+        INA260_MASK_ENABLE_REGISTER,
+        INA260_CURRENT_REGISTER,
+        INA260_VOLTAGE_REGISTER,
+        INA260_POWER_REGISTER
+    };
+    return start(snapshotRegs, 4);
+}
+
+/*!
+ *  @brief Advances the read by polling the bus once. Never blocks.
+ *
+ *  @return ASYNC_BUSY while in progress, then ASYNC_DONE or ASYNC_FAILED,
+ *  which stays until the next start(). The callback runs once, on the
+ *  call that finishes the read.
+*/
+template <class Transport>
+AsyncState INA260AsyncReader<Transport>::step(void) {
+    if (state != ASYNC_BUSY) {
+        return state;
+    }
+    switch (device->transport().poll()) {
+        case TRANSFER_BUSY:
+            return ASYNC_BUSY;
+        case TRANSFER_DONE:
+            values[index] = (static_cast<uint16_t>(data[0]) << 8) | data[1];
+            index++;
+            if (index == count) {
+                return finish(ASYNC_DONE);
+            }
+            if (! startNext()) {
+                return finish(ASYNC_FAILED);
+            }
+            return ASYNC_BUSY;
+        default:
+            return finish(ASYNC_FAILED);
+    }
+}
+
+/*!
+ *  @brief Gets the state of the reader without touching the bus.
+ *
+ *  @return The current state.
+*/
+template <class Transport>
+AsyncState INA260AsyncReader<Transport>::getState(void) const {
+    return state;
+}
+
+/*!
+ *  @brief Gets one register value of the last read.
+ *
+ *  @param index Position of the register in the list given to start().
+ *  @return The value, with STATUS_READ_FAILED if it was not read.
+*/
+template <class Transport>
+Reading<uint16_t> INA260AsyncReader<Transport>::result(uint8_t index) const {
+    if (index >= count || (state != ASYNC_DONE && index >= this->index)) {
+        return Reading<uint16_t>{ 0, STATUS_READ_FAILED };
+    }
+    return Reading<uint16_t>{ values[index], STATUS_OK };
+}
+
+/*!
+ *  @brief Gets the result of a finished startSnapshot().
+ *
+ *  @param snapshot Receives the values.
+ *  @return True if a snapshot read finished successfully, otherwise false.
+*/
+template <class Transport>
+bool INA260AsyncReader<Transport>::snapshot(Snapshot &snapshot) const {
+    if (state != ASYNC_DONE || count != 4 ||
+        regs[0] != INA260_MASK_ENABLE_REGISTER || regs[1] != INA260_CURRENT_REGISTER ||
+        regs[2] != INA260_VOLTAGE_REGISTER || regs[3] != INA260_POWER_REGISTER) {
+        return false;
+    }
+    snapshot.flags.rawValue = values[0];
+    snapshot.current = values[1];
+    snapshot.voltage = values[2];
+    snapshot.power = values[3];
+    return true;
+}
+
+/*!
+ *  @brief Starts the bus transfer for the register at index.
+ *
+ *  @return True if the transport accepted the transfer.
+*/
+template <class Transport>
+bool INA260AsyncReader<Transport>::startNext(void) {
+    return device->transport().startWriteRead(device->getAddress(), &regs[index], 1, data, 2);
+}
+
+/*!
+ *  @brief Records the outcome and runs the completion callback.
+ *
+ *  @return The final state.
+*/
+template <class Transport>
+AsyncState INA260AsyncReader<Transport>::finish(AsyncState result) {
+    state = result;
+    if (callback != nullptr) {
+        callback(*this, context);
+    }
+    return result;
+}
+
+#endif // INA260Async.H
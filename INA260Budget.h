@@ -0,0 +1,122 @@
+#ifndef INA260Budget_h
+#define INA260Budget_h
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "INA260Stats.h"
+
+/*
+ *  Transaction budgets for the public INA260Device calls.
+ *
+ *  Each entry is the largest number of register transactions one call
+ *  may make with the default settings (pointer cache on, shadow
+ *  registers off), including the retries the call makes by design. Bus
+ *  probes are not counted. checkBudget() compares the most transactions
+ *  any single call made, from the INA260_ENABLE_STATS counters, against
+ *  the table, so a change that adds bus traffic to a call shows up as a
+ *  violation from any harness or sketch exercising the driver however
+ *  many cheaper calls it also made. test/TestTransactionCounts pins the
+ *  exact counts. Like the counters, the table is only declared with
+ *  INA260_ENABLE_STATS.
+*/
+
+#ifdef INA260_ENABLE_STATS
+
+#define INA260_BUDGET_UNBOUNDED         0xFF // Call whose traffic depends on the bus contents
+
+/*!
+ *  @brief Gets the transaction budget of a public call.
+ *
+ *  @param api The call.
+ *  @return Maximum register transactions per call, or
+ *  INA260_BUDGET_UNBOUNDED.
+*/
+inline uint8_t transactionBudget(Api api) {
+    static const uint8_t budgets[API_COUNT] = {
+        INA260_BUDGET_UNBOUNDED, // API_NONE
+        1,                       // API_BEGIN: reset write
+        1,                       // API_RESET
+        0,                       // API_FIND_DEVICES: probes only
+        INA260_BUDGET_UNBOUNDED, // API_SCAN_DEVICES: two ID reads per device found
+        2,                       // API_RESYNC
+        1,                       // API_READ_CONFIGURATION
+        1,                       // API_WRITE_CONFIGURATION
+        1,                       // API_CONFIGURE
+        1,                       // API_READ_CURRENT
+        1,                       // API_READ_BUS_VOLTAGE
+        1,                       // API_READ_POWER
+        5,                       // API_READ_SNAPSHOT: four reads, a fifth to bracket, no retries
+        5 + INA260_TRIGGER_ATTEMPTS, // API_MEASURE_ONCE: configuration read, trigger, every ready check, three reads
+        1,                       // API_READ_MASK_ENABLE
+        1,                       // API_WRITE_MASK_ENABLE
+        2,                       // API_READ_ALERT_LIMIT: mask/enable, then limit
+        1,                       // API_WRITE_ALERT_LIMIT
+        3,                       // API_ENABLE_OVER_CURRENT_ALERT: read mask, write limit, write mask
+        3,                       // API_ENABLE_UNDER_CURRENT_ALERT
+        3,                       // API_ENABLE_BUS_OVER_ALERT
+        3,                       // API_ENABLE_BUS_UNDER_ALERT
+        3,                       // API_ENABLE_OVER_POWER_ALERT
+        1,                       // API_SET_CURRENT_LIMIT
+        1,                       // API_SET_BUS_VOLTAGE_LIMIT
+        1,                       // API_SET_POWER_LIMIT
+        1,                       // API_IS_MATH_OVERFLOW
+        1,                       // API_IS_ALERT
+        1,                       // API_CLEAR_ALERT
+        1,                       // API_IS_ALERT_POLARITY_SET
+        2,                       // API_SET_ALERT_POLARITY
+        1,                       // API_IS_ALERT_LATCH_SET
+        2,                       // API_SET_ALERT_LATCH
+        1,                       // API_GET_MODE
+        2,                       // API_SET_MODE
+        1,                       // API_IS_CONVERSION_READY
+        2,                       // API_SET_CONVERSION_READY_ALERT
+        1,                       // API_GET_CURRENT_CONVERSION_TIME
+        2,                       // API_SET_CURRENT_CONVERSION_TIME
+        1,                       // API_GET_VOLTAGE_CONVERSION_TIME
+        2,                       // API_SET_VOLTAGE_CONVERSION_TIME
+        1,                       // API_GET_AVERAGING_COUNT
+        2,                       // API_SET_AVERAGING_COUNT
+        1,                       // API_READ_MANUFACTURER_ID
+        1,                       // API_READ_DIE_ID
+    };
+    return (api < API_COUNT) ? budgets[api] : INA260_BUDGET_UNBOUNDED;
+}
+
+/*!
+ *  @brief Checks recorded bus traffic against the transaction budgets,
+ *  call by call.
+ *
+ *  @param stats Counters collected with INA260_ENABLE_STATS.
+ *  @param report Called with a description of each violation, may be
+ *  nullptr.
+ *  @param context Passed to report unchanged.
+ *  @return The number of calls that exceeded their budget.
+*/
+inline uint8_t checkBudget(const INA260Stats &stats,
+                           void (*report)(const char *line, void *context) = nullptr,
+                           void *context = nullptr) {
+    uint8_t violations = 0;
+    for (uint8_t i = 0; i < API_COUNT; i++) {
+        const Api api = static_cast<Api>(i);
+        const ApiStats &a = stats.apis[i];
+        const uint8_t budget = transactionBudget(api);
+        if (budget == INA260_BUDGET_UNBOUNDED || a.calls == 0) {
+            continue;
+        }
+        if (a.maxTransactions > budget) {
+            violations++;
+            if (report != nullptr) {
+                char line[96];
+                snprintf(line, sizeof(line), "%s: %lu transactions in one call, budget %u",
+                         INA260Stats::apiName(api), (unsigned long)a.maxTransactions, budget);
+                report(line, context);
+            }
+        }
+    }
+    return violations;
+}
+
+#endif
+
+#endif // INA260Budget.H
@@ -0,0 +1,113 @@
+#if defined(__linux__) && !defined(ARDUINO)
+
+#include "INA260BusTiming.h"
+
+// Bus clocks per transaction: 9 per byte (8 data + ACK), 1 for each
+// START/repeated START and 1 for the STOP.
+#define READ_CLOCKS        (1 + 9 * 2 + 1 + 9 * 3 + 1) // S addr reg Sr addr msb lsb P
+#define CACHED_READ_CLOCKS (1 + 9 * 3 + 1)             // S addr msb lsb P
+#define WRITE_CLOCKS       (1 + 9 * 4 + 1)             // S addr reg msb lsb P
+
+// High-speed transfers are preceded by the master code, sent at 400 kHz.
+#define HS_MASTER_CODE_NANOS ((1 + 9) * 1000000000ULL / BUS_FAST)
+
+/*!
+ *  @brief Gets the transactions the driver makes for a call, matching
+ *  the implementation in INA260.tpp.
+ *
+ *  @param call The driver call.
+ *  @return The transaction pattern.
+*/
+TransactionPattern transactionPattern(DriverCall call) {
+    switch (call) {
+        case CALL_READ_REGISTER:                 return TransactionPattern{ 1, 0, 0 };
+        case CALL_READ_REGISTER_CACHED:          return TransactionPattern{ 0, 1, 0 };
+        case CALL_READ_MEASUREMENTS:             return TransactionPattern{ 3, 0, 0 };
+        case CALL_READ_SNAPSHOT:                 return TransactionPattern{ 4, 0, 0 };
+        case CALL_READ_SNAPSHOT_SAME_CONVERSION: return TransactionPattern{ 5, 0, 0 };
+        case CALL_IS_CONVERSION_READY:           return TransactionPattern{ 1, 0, 0 };
+        case CALL_SET_FIELD:                     return TransactionPattern{ 1, 0, 1 };
+        case CALL_SET_FIELD_SHADOWED:            return TransactionPattern{ 0, 0, 1 };
+        case CALL_CONFIGURE_COMMIT:              return TransactionPattern{ 0, 0, 1 };
+        case CALL_MEASURE_ONCE:                  return TransactionPattern{ 4, 0, 1 };
+        default:                                 return TransactionPattern{ 0, 0, 0 };
+    }
+}
+
+/*!
+ *  @brief Computes how long a transaction pattern occupies the bus.
+ *
+ *  @param pattern The transactions.
+ *  @param busHz The bus clock in Hz.
+ *  @return Bus time in nanoseconds.
+*/
+uint32_t transactionNanos(TransactionPattern pattern, uint32_t busHz) {
+    if (busHz == 0) {
+        return 0;
+    }
+    const uint32_t clocks = pattern.reads * READ_CLOCKS +
+                            pattern.cachedReads * CACHED_READ_CLOCKS +
+                            pattern.writes * WRITE_CLOCKS;
+    uint64_t nanos = clocks * 1000000000ULL / busHz;
+    if (busHz > BUS_FAST_PLUS) {
+        nanos += (pattern.reads + pattern.cachedReads + pattern.writes) * HS_MASTER_CODE_NANOS;
+    }
+    return static_cast<uint32_t>(nanos);
+}
+
+/*!
+ *  @brief Predicts bus occupancy and sustainable sample rates for a set
+ *  of devices sharing one bus.
+ *
+ *  @param devices The devices and how they are polled.
+ *  @param count The number of devices.
+ *  @param busHz The bus clock in Hz.
+ *  @param capacities Optional array of count entries receiving the
+ *  limits of each device.
+ *  @return The predicted load of the bus.
+*/
+BusPrediction predictBusLoad(const DeviceLoad *devices, uint8_t count, uint32_t busHz,
+                             DeviceCapacity *capacities) {
+    BusPrediction prediction = {};
+    uint64_t roundNanos = 0;   // Bus time to sample every device once
+    uint64_t busyPerSecond = 0; // Nanoseconds of bus time per second at the requested rates
+
+    for (uint8_t i = 0; i < count; i++) {
+        roundNanos += transactionNanos(devices[i].pattern, busHz);
+    }
+    if (roundNanos > 0) {
+        prediction.maxCommonMilliHz = static_cast<uint32_t>(1000000000000ULL / roundNanos);
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+        DeviceCapacity capacity = {};
+        const uint32_t period = conversionPeriodMicros(devices[i].config);
+        capacity.conversionMilliHz = (period == 0) ? 0 : static_cast<uint32_t>(1000000000ULL / period);
+        capacity.sampleNanos = transactionNanos(devices[i].pattern, busHz);
+
+        capacity.maxMilliHz = prediction.maxCommonMilliHz;
+        if (capacity.conversionMilliHz != 0 && capacity.conversionMilliHz < capacity.maxMilliHz) {
+            capacity.maxMilliHz = capacity.conversionMilliHz;
+        }
+
+        uint32_t poll = devices[i].pollMilliHz;
+        if (poll == 0) {
+            poll = prediction.maxCommonMilliHz;
+        }
+        capacity.oversampled = (poll > capacity.conversionMilliHz);
+        if (capacity.oversampled) {
+            prediction.oversampled++;
+        }
+        busyPerSecond += static_cast<uint64_t>(capacity.sampleNanos) * poll / 1000;
+
+        if (capacities != nullptr) {
+            capacities[i] = capacity;
+        }
+    }
+
+    prediction.occupancy = static_cast<uint32_t>(busyPerSecond / 1000000);
+    prediction.overloaded = (prediction.occupancy > 1000);
+    return prediction;
+}
+
+#endif // __linux__
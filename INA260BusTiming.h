@@ -0,0 +1,73 @@
+#ifndef INA260BusTiming_h
+#define INA260BusTiming_h
+
+#include <stdint.h>
+
+#include "INA260.h"
+
+typedef enum _busClock {
+    BUS_STANDARD   = 100000,  // Standard mode, 100 kHz
+    BUS_FAST       = 400000,  // Fast mode, 400 kHz
+    BUS_FAST_PLUS  = 1000000, // Fast mode plus, 1 MHz
+    BUS_HIGH_SPEED = 2940000, // High-speed mode, 2.94 MHz (INA260 maximum)
+} BusClock;
+
+typedef enum _driverCall {
+    CALL_READ_REGISTER = 0,             // readCurrent(), readBusVoltage(), readPower(), ...
+    CALL_READ_REGISTER_CACHED,          // The same, repeating the previous register
+    CALL_READ_MEASUREMENTS,             // readCurrent() + readBusVoltage() + readPower()
+    CALL_READ_SNAPSHOT,                 // readSnapshot()
+    CALL_READ_SNAPSHOT_SAME_CONVERSION, // readSnapshot(snapshot, true), no retries
+    CALL_IS_CONVERSION_READY,           // isConversionRready()
+    CALL_SET_FIELD,                     // setMode(), setAveragingCount(), ... read-modify-write
+    CALL_SET_FIELD_SHADOWED,            // The same, with shadow registers enabled
+    CALL_CONFIGURE_COMMIT,              // configureDefaults()...commit()
+    CALL_MEASURE_ONCE,                  // measureOnce(), shadow registers enabled, no retries
+} DriverCall;
+
+/*!
+ *  @brief The bus transactions one driver call makes.
+*/
+struct TransactionPattern {
+    uint8_t reads;       // Pointer write + repeated start + 2-byte read
+    uint8_t cachedReads; // 2-byte read reusing the cached pointer
+    uint8_t writes;      // 3-byte register write
+};
+
+/*!
+ *  @brief One device's share of the bus: how it is configured, what the
+ *  driver does per sample and how often it is polled.
+*/
+struct DeviceLoad {
+    ConfigurationRegister config;
+    TransactionPattern pattern;
+    uint32_t pollMilliHz; // Requested samples per second x 1000, 0 for as fast as possible
+};
+
+/*!
+ *  @brief Predicted limits for one device.
+*/
+struct DeviceCapacity {
+    uint32_t conversionMilliHz; // New results the device produces per second x 1000
+    uint32_t maxMilliHz;        // Sustainable samples per second x 1000 (device or bus bound)
+    uint32_t sampleNanos;       // Bus time taken by one sample
+    bool oversampled;           // Polled faster than the device produces new data
+};
+
+/*!
+ *  @brief Predicted load of a whole bus segment.
+*/
+struct BusPrediction {
+    uint32_t occupancy;      // Bus busy time at the requested rates, parts per thousand
+    uint32_t maxCommonMilliHz; // Rate every device could be polled at if the bus were the only limit
+    bool overloaded;         // The requested rates need more than the whole bus
+    uint8_t oversampled;     // Number of devices polled faster than they convert
+};
+
+// Host-side planning helpers; not compiled into Arduino sketches.
+TransactionPattern transactionPattern(DriverCall call);
+uint32_t transactionNanos(TransactionPattern pattern, uint32_t busHz);
+BusPrediction predictBusLoad(const DeviceLoad *devices, uint8_t count, uint32_t busHz,
+                             DeviceCapacity *capacities = nullptr);
+
+#endif // INA260BusTiming.H
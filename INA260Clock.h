@@ -0,0 +1,65 @@
+#ifndef INA260Clock_h
+#define INA260Clock_h
+
+#include <stdint.h>
+
+#ifdef ARDUINO
+    #ifndef Arduino
+        #include "Arduino.h"
+    #endif
+#else
+    #include <errno.h>
+    #include <time.h>
+#endif
+
+/*!
+ *  @brief Microsecond timestamp source used by the library's timed
+ *  helpers. Wraps after about 71 minutes; compare timestamps by
+ *  subtraction.
+ *
+ *  @return Microseconds since an arbitrary start point.
+*/
+inline uint32_t ina260Micros(void) {
+#ifdef ARDUINO
+    return micros();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint32_t>(ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000);
+#endif
+}
+
+/*!
+ *  @brief Waits at least the given time, letting other work run where
+ *  the platform allows: delay() yields to the scheduler on cores that
+ *  have one, and nanosleep() gives the CPU back on Linux.
+ *
+ *  @param us The time to wait in microseconds.
+*/
+inline void ina260SleepMicros(uint32_t us) {
+#ifdef ARDUINO
+    if (us >= 1000) {
+        delay(us / 1000);
+    }
+    delayMicroseconds(us % 1000);
+#else
+    struct timespec ts;
+    ts.tv_sec = us / 1000000;
+    ts.tv_nsec = static_cast<long>(us % 1000000) * 1000;
+    while (nanosleep(&ts, &ts) != 0 && errno == EINTR) {
+    }
+#endif
+}
+
+/*!
+ *  @brief Signature of a replacement clock, e.g. a simulated one.
+*/
+typedef uint32_t (*INA260ClockFunction)(void);
+
+/*!
+ *  @brief Signature of a replacement sleep, e.g. one advancing a
+ *  simulated clock.
+*/
+typedef void (*INA260SleepFunction)(uint32_t us);
+
+#endif // INA260Clock.H
@@ -0,0 +1,132 @@
+#if defined(__linux__) && !defined(ARDUINO)
+
+#include <string.h>
+
+#include "INA260Integrator.h"
+
+/*!
+ *  @brief Instantiates an integrator with zero totals.
+ *
+ *  @param maxGapMicros Longest interval treated as consecutive samples.
+*/
+INA260Integrator::INA260Integrator(uint32_t maxGapMicros) :
+    maxGap(maxGapMicros),
+    lastMicros(0),
+    lastCurrent(0),
+    lastPower(0),
+    started(false) {
+    memset(&totals, 0, sizeof(totals));
+    memset(&baseline, 0, sizeof(baseline));
+}
+
+/*!
+ *  @brief Sets the longest interval between samples that is not a gap.
+ *  A few sample periods is a good choice.
+ *
+ *  @param maxGapMicros The interval in microseconds.
+*/
+void INA260Integrator::setMaxGap(uint32_t maxGapMicros) {
+    maxGap = maxGapMicros;
+}
+
+/*!
+ *  @brief Integrates one sample. The first sample only sets the time
+ *  base.
+ *
+ *  @param rawCurrent The Current register value.
+ *  @param rawPower The Power register value.
+ *  @param micros When the sample was taken; wraps like ina260Micros(),
+ *  so samples must be less than 71 minutes apart.
+*/
+void INA260Integrator::add(uint16_t rawCurrent, uint16_t rawPower, uint32_t micros) {
+    const int16_t current = static_cast<int16_t>(rawCurrent);
+    if (! started) {
+        started = true;
+    } else {
+        const uint32_t interval = micros - lastMicros;
+        int64_t charge;
+        uint64_t energy;
+        if (interval > maxGap) {
+            charge = (static_cast<int64_t>(lastCurrent) + current) * interval;
+            energy = (static_cast<uint64_t>(lastPower) + rawPower) * interval;
+        } else {
+            charge = static_cast<int64_t>(current) * 2 * interval;
+            energy = static_cast<uint64_t>(rawPower) * 2 * interval;
+        }
+
+        totals.charge += charge;
+        totals.energy += energy;
+        totals.micros += interval;
+        totals.samples++;
+        if (interval > maxGap) {
+            totals.gapMicros += interval;
+            totals.gaps++;
+        }
+        published.write(totals);
+    }
+    lastMicros = micros;
+    lastCurrent = current;
+    lastPower = rawPower;
+}
+
+/*!
+ *  @brief Integrates the current and power of a snapshot.
+ *
+ *  @param snapshot The sample.
+ *  @param micros When the sample was taken.
+*/
+void INA260Integrator::add(const Snapshot &snapshot, uint32_t micros) {
+    add(snapshot.current, snapshot.power, micros);
+}
+
+/*!
+ *  @brief Copies the totals since the last reset, unless add() is
+ *  updating them right now.
+ *
+ *  @param totals Receives the totals.
+ *  @return True if a consistent copy was made, otherwise false.
+*/
+bool INA260Integrator::tryRead(IntegratorTotals &totals) const {
+    IntegratorTotals copy;
+    if (! published.tryRead(copy)) {
+        return false;
+    }
+    totals.charge = copy.charge - baseline.charge;
+    totals.energy = copy.energy - baseline.energy;
+    totals.micros = copy.micros - baseline.micros;
+    totals.gapMicros = copy.gapMicros - baseline.gapMicros;
+    totals.samples = copy.samples - baseline.samples;
+    totals.gaps = copy.gaps - baseline.gaps;
+    return true;
+}
+
+/*!
+ *  @brief Gets the totals since the last reset.
+ *
+ *  @return The totals.
+*/
+IntegratorTotals INA260Integrator::read(void) const {
+    IntegratorTotals result;
+    while (! tryRead(result)) {
+    }
+    return result;
+}
+
+/*!
+ *  @brief Gets the totals since the last reset and starts a new period.
+ *  Sampling continues undisturbed; no sample is lost or counted twice.
+ *
+ *  @return The totals of the period that ended.
+*/
+IntegratorTotals INA260Integrator::readAndReset(void) {
+    const IntegratorTotals result = read();
+    baseline.charge += result.charge;
+    baseline.energy += result.energy;
+    baseline.micros += result.micros;
+    baseline.gapMicros += result.gapMicros;
+    baseline.samples += result.samples;
+    baseline.gaps += result.gaps;
+    return result;
+}
+
+#endif // __linux__
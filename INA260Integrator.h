@@ -0,0 +1,79 @@
+#ifndef INA260Integrator_h
+#define INA260Integrator_h
+
+#include <stdint.h>
+
+#include "INA260.h"
+#include "INA260SeqLock.h"
+
+/*!
+ *  @brief Charge and energy accumulated by INA260Integrator.
+ *
+ *  charge is kept in 0.625 mA x us (half a Current LSB for one
+ *  microsecond) and energy in 5 mW x us (half a Power LSB), so both
+ *  rectangle and trapezoid steps are exact integers and nothing drifts.
+ *  At the full scale of the registers they last over four years before
+ *  overflowing.
+*/
+struct IntegratorTotals {
+    int64_t charge;     // 0.625 mA x us, negative for reverse current
+    uint64_t energy;    // 5 mW x us
+    uint64_t micros;    // Time covered by the samples
+    uint64_t gapMicros; // Part of micros bridged across missed samples
+    uint32_t samples;   // Samples integrated
+    uint32_t gaps;      // Intervals longer than the maximum gap
+
+    int64_t chargeMicroCoulombs(void) const { return charge / 1600; }
+    int64_t chargeMicroAmpHours(void) const { return charge / 5760000; }
+    uint64_t energyMicroJoules(void) const { return energy / 200; }
+    uint64_t energyMicroWattHours(void) const { return energy / 720000; }
+
+    double chargeMilliAmpHours(void) const { return charge / 5.76e9; }
+    double energyMilliWattHours(void) const { return energy / 7.2e8; }
+    double energyJoules(void) const { return energy / 2e8; }
+};
+
+/*!
+ *  @brief Coulomb and energy counter fed with successive samples.
+ *
+ *  Each sample is the average over the conversion that just completed,
+ *  so it is held over the interval since the previous sample. An
+ *  interval longer than the maximum gap (a missed sample, a bus error)
+ *  is bridged with the mean of the samples either side and counted, so
+ *  the caller can see how much of the total is interpolated.
+ *
+ *  add() may run in another thread or an interrupt while read() or
+ *  readAndReset() runs: the totals are published through an
+ *  INA260SeqLock and readers retry until they get a consistent copy.
+ *  There must be one writer. readAndReset() moves the reset baseline,
+ *  which read() and tryRead() use unguarded, so all three must be
+ *  called from the same thread. Readers must not interrupt add() on the
+ *  same core; use tryRead() from such a context.
+ *
+ *  @note Linux only: INA260Integrator.cpp is compiled out under ARDUINO.
+*/
+class INA260Integrator {
+    public:
+        explicit INA260Integrator(uint32_t maxGapMicros = 1000000);
+
+        void setMaxGap(uint32_t maxGapMicros);
+
+        void add(uint16_t rawCurrent, uint16_t rawPower, uint32_t micros);
+        void add(const Snapshot &snapshot, uint32_t micros);
+
+        bool tryRead(IntegratorTotals &totals) const;
+        IntegratorTotals read(void) const;
+        IntegratorTotals readAndReset(void);
+
+    private:
+        IntegratorTotals totals;   // Writer's copy
+        INA260SeqLock<IntegratorTotals> published;
+        IntegratorTotals baseline; // Totals at the last readAndReset()
+        uint32_t maxGap;
+        uint32_t lastMicros;
+        int16_t lastCurrent;
+        uint16_t lastPower;
+        bool started;
+};
+
+#endif // INA260Integrator.H
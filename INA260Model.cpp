@@ -0,0 +1,346 @@
+#if defined(__linux__) && !defined(ARDUINO)
+
+#include "INA260Model.h"
+
+/*!
+ *  @brief Instantiates a device model in its power-on state.
+ *
+ *  @param address The address the model answers on.
+*/
+INA260Model::INA260Model(uint8_t address) :
+    address(address),
+    pointer(0),
+    waveform(nullptr),
+    context(nullptr),
+    constantMicroAmps(0),
+    constantMicroVolts(0),
+    alertAsserted(false),
+    alertEdges(0),
+    alertEdgeMicros(0),
+    now(0) {
+    reset();
+}
+
+/*!
+ *  @brief Gets the address the model answers on.
+ *
+ *  @return The device address.
+*/
+uint8_t INA260Model::getAddress(void) const {
+    return address;
+}
+
+/*!
+ *  @brief Sets the function supplying the measured signal.
+ *
+ *  @param waveform The signal source, nullptr for the constant signal.
+ *  @param context Passed to the waveform unchanged.
+*/
+void INA260Model::setWaveform(Waveform waveform, void *context) {
+    this->waveform = waveform;
+    this->context = context;
+}
+
+/*!
+ *  @brief Sets a constant signal, used when no waveform is set.
+ *
+ *  @param microAmps The shunt current.
+ *  @param microVolts The bus voltage.
+*/
+void INA260Model::setConstant(int32_t microAmps, uint32_t microVolts) {
+    constantMicroAmps = microAmps;
+    constantMicroVolts = microVolts;
+}
+
+/*!
+ *  @brief Puts all registers in their power-on state, as the RST bit does,
+ *  and starts converting in the default continuous mode.
+*/
+void INA260Model::reset(void) {
+    config.rawValue = INA260_CONFIG_DEFAULT;
+    maskEnable.rawValue = 0;
+    current = 0;
+    voltage = 0;
+    power = 0;
+    alertLimit = 0;
+    alertAsserted = false;
+    conversions = 0;
+    startConversion(now);
+}
+
+/*!
+ *  @brief Runs the device up to a point in virtual time, completing any
+ *  conversions that finish on the way.
+ *
+ *  @param now Virtual time in microseconds; earlier times are ignored.
+*/
+void INA260Model::update(uint64_t now) {
+    while (nextSample != 0 && nextSample <= now) {
+        int32_t microAmps = constantMicroAmps;
+        uint32_t microVolts = constantMicroVolts;
+        if (waveform != nullptr) {
+            waveform(context, nextSample, microAmps, microVolts);
+        }
+        currentSum += microAmps;
+        voltageSum += microVolts;
+        samplesTaken++;
+
+        const uint64_t sampleEnd = nextSample;
+        nextSample += sampleMicros();
+        if (samplesTaken >= averagingSamples(static_cast<AveragingCount>(config.avg))) {
+            this->now = sampleEnd;
+            completeConversion();
+            if (config.mode & MODE_CONT_POWER_DOWN) {
+                startConversion(sampleEnd);
+            } else {
+                nextSample = 0;
+            }
+        }
+    }
+    if (now > this->now) {
+        this->now = now;
+    }
+}
+
+/*!
+ *  @brief Reads a register with the side effects of a bus read: reading
+ *  the MaskEnableRegister clears the Conversion Ready Flag and, in
+ *  latched mode, the Alert Function Flag and the ALERT pin.
+ *
+ *  @param reg The register to read.
+ *  @return The register value, 0 for unimplemented registers.
+*/
+uint16_t INA260Model::readRegister(uint8_t reg) {
+    const uint16_t value = peekRegister(reg);
+    if (reg == INA260_MASK_ENABLE_REGISTER) {
+        maskEnable.cvrf = 0;
+        if (maskEnable.len) {
+            maskEnable.aff = 0;
+        }
+        refreshAlert();
+    }
+    return value;
+}
+
+/*!
+ *  @brief Writes a register with the side effects of a bus write.
+ *  Writing the ConfigurationRegister restarts conversion (or resets the
+ *  device when RST is set); read-only registers ignore writes.
+ *
+ *  @param reg The register to write.
+ *  @param value The value to write.
+*/
+void INA260Model::writeRegister(uint8_t reg, uint16_t value) {
+    switch (reg) {
+        case INA260_CONFIG_REGISTER:
+            config.rawValue = value;
+            if (config.rst) {
+                reset();
+                break;
+            }
+            maskEnable.cvrf = 0;
+            refreshAlert();
+            startConversion(now);
+            break;
+        case INA260_MASK_ENABLE_REGISTER:
+            maskEnable.rawValue = (maskEnable.rawValue & ~INA260_MASK_ENABLE_WRITABLE) |
+                                  (value & INA260_MASK_ENABLE_WRITABLE);
+            refreshAlert();
+            break;
+        case INA260_ALERT_LIMIT_REGISTER:
+            alertLimit = value;
+            break;
+        default:
+            break;
+    }
+}
+
+/*!
+ *  @brief Reads a register without side effects, for inspection.
+ *
+ *  @param reg The register to read.
+ *  @return The register value, 0 for unimplemented registers.
+*/
+uint16_t INA260Model::peekRegister(uint8_t reg) const {
+    switch (reg) {
+        case INA260_CONFIG_REGISTER:          return config.rawValue;
+        case INA260_CURRENT_REGISTER:         return current;
+        case INA260_VOLTAGE_REGISTER:         return voltage;
+        case INA260_POWER_REGISTER:           return power;
+        case INA260_MASK_ENABLE_REGISTER:     return maskEnable.rawValue;
+        case INA260_ALERT_LIMIT_REGISTER:     return alertLimit;
+        case INA260_MANUFACTURER_ID_REGISTER: return INA260_MANUFACTURER_ID;
+        case INA260_DIE_ID_REGISTER:          return INA260_DIE_ID << 4;
+        default:                              return 0;
+    }
+}
+
+/*!
+ *  @brief Gets the register pointer.
+ *
+ *  @return The register the next read returns.
+*/
+uint8_t INA260Model::getPointer(void) const {
+    return pointer;
+}
+
+/*!
+ *  @brief Sets the register pointer, as the first byte of a bus write does.
+ *
+ *  @param reg The register the next read returns.
+*/
+void INA260Model::setPointer(uint8_t reg) {
+    pointer = reg;
+}
+
+/*!
+ *  @brief Is the ALERT function currently asserted.
+ *
+ *  @return True if asserted, otherwise false.
+*/
+bool INA260Model::isAlertAsserted(void) const {
+    return alertAsserted;
+}
+
+/*!
+ *  @brief Gets the electrical level of the open-drain ALERT pin, which is
+ *  pulled low when asserted unless the Alert Polarity bit inverts it.
+ *
+ *  @return True for high, false for low.
+*/
+bool INA260Model::getAlertPinLevel(void) const {
+    return alertAsserted ? maskEnable.apol : ! maskEnable.apol;
+}
+
+/*!
+ *  @brief Gets the number of averaged results produced since reset.
+ *
+ *  @return The number of completed conversions.
+*/
+uint32_t INA260Model::getConversionCount(void) const {
+    return conversions;
+}
+
+/*!
+ *  @brief Gets the number of times ALERT has been asserted, so a pin
+ *  source can see every edge however rarely it looks. The count is not
+ *  cleared by a reset.
+ *
+ *  @return The number of ALERT assertions.
+*/
+uint32_t INA260Model::getAlertEdgeCount(void) const {
+    return alertEdges;
+}
+
+/*!
+ *  @brief Gets the virtual time of the latest ALERT assertion.
+ *
+ *  @return The time in microseconds, 0 if ALERT was never asserted.
+*/
+uint64_t INA260Model::getLastAlertEdgeMicros(void) const {
+    return alertEdgeMicros;
+}
+
+/*!
+ *  @brief Gets the duration of one sample (current and/or bus voltage
+ *  conversion) in the current mode.
+ *
+ *  @return The sample time in microseconds, 0 in power-down modes.
+*/
+uint32_t INA260Model::sampleMicros(void) const {
+    ConfigurationRegister single = config;
+    single.avg = AVG_1;
+    return conversionPeriodMicros(single);
+}
+
+/*!
+ *  @brief Starts a new averaged conversion, or stops converting in the
+ *  power-down modes.
+ *
+ *  @param at Virtual time the conversion starts.
+*/
+void INA260Model::startConversion(uint64_t at) {
+    samplesTaken = 0;
+    currentSum = 0;
+    voltageSum = 0;
+    const uint32_t sample = sampleMicros();
+    nextSample = (sample == 0) ? 0 : at + sample;
+}
+
+/*!
+ *  @brief Latches the averaged result into the measurement registers,
+ *  raises the Conversion Ready Flag and evaluates the alert function.
+*/
+void INA260Model::completeConversion(void) {
+    const int64_t microAmps = currentSum / samplesTaken;
+    const int64_t microVolts = voltageSum / samplesTaken;
+
+    if (config.mode & MODE_TRIG_ISH) {
+        int64_t raw = microAmps / 1250;
+        raw = (raw > INT16_MAX) ? INT16_MAX : (raw < INT16_MIN) ? INT16_MIN : raw;
+        current = static_cast<uint16_t>(static_cast<int16_t>(raw));
+    }
+    if (config.mode & MODE_TRIG_VBUS) {
+        const int64_t raw = microVolts / 1250;
+        voltage = (raw > 0x7FFF) ? 0x7FFF : static_cast<uint16_t>(raw);
+    }
+
+    // Power is computed from the register values, as the device does.
+    const int32_t currentRaw = static_cast<int16_t>(current);
+    const uint64_t microWatts = static_cast<uint64_t>(currentRaw < 0 ? -currentRaw : currentRaw) *
+                                voltage * 1250ULL * 1250ULL / 1000000ULL;
+    const uint64_t powerRaw = microWatts / 10000;
+    maskEnable.ovf = (powerRaw > 0xFFFF);
+    power = (powerRaw > 0xFFFF) ? 0xFFFF : static_cast<uint16_t>(powerRaw);
+
+    conversions++;
+    maskEnable.cvrf = 1;
+
+    const bool exceeded = limitExceeded();
+    if (exceeded) {
+        maskEnable.aff = 1;
+    } else if (! maskEnable.len) {
+        maskEnable.aff = 0;
+    }
+    refreshAlert();
+}
+
+/*!
+ *  @brief Drives the ALERT output from the Alert Function Flag and, when
+ *  enabled, the Conversion Ready Flag.
+*/
+void INA260Model::refreshAlert(void) {
+    const bool asserted = maskEnable.aff || (maskEnable.cnvr && maskEnable.cvrf);
+    if (asserted && ! alertAsserted) {
+        alertEdges++;
+        alertEdgeMicros = now;
+    }
+    alertAsserted = asserted;
+}
+
+/*!
+ *  @brief Compares the latest result against the Alert Limit Register
+ *  using the enabled alert function.
+ *
+ *  @return True if the enabled limit is exceeded, otherwise false.
+*/
+bool INA260Model::limitExceeded(void) const {
+    if (maskEnable.ocl) {
+        return static_cast<int16_t>(current) > static_cast<int16_t>(alertLimit);
+    }
+    if (maskEnable.ucl) {
+        return static_cast<int16_t>(current) < static_cast<int16_t>(alertLimit);
+    }
+    if (maskEnable.bol) {
+        return voltage > alertLimit;
+    }
+    if (maskEnable.bul) {
+        return voltage < alertLimit;
+    }
+    if (maskEnable.pol) {
+        return power > alertLimit;
+    }
+    return false;
+}
+
+#endif // __linux__
@@ -0,0 +1,91 @@
+#ifndef INA260Model_h
+#define INA260Model_h
+
+#include <stdint.h>
+
+#include "INA260.h"
+
+/*!
+ *  @brief Register-accurate software model of one INA260, for running and
+ *  timing the driver without hardware.
+ *
+ *  The model implements every register in INA260.h: reset through the
+ *  RST bit, continuous and triggered conversions timed from the
+ *  conversion time and averaging settings, the Conversion Ready Flag
+ *  (cleared by reading the MaskEnableRegister or writing the
+ *  ConfigurationRegister), the alert limit comparisons with the Alert
+ *  Function Flag in transparent and latched modes, the math overflow
+ *  flag and the ALERT pin. The measured signal comes from a waveform
+ *  callback sampled on a virtual microsecond clock, which only moves
+ *  when update() is called (SimulatedTransport does that for every bus
+ *  transaction).
+ *
+ *  @note Only built for Linux hosts; Arduino sketches do not get it.
+*/
+class INA260Model {
+    public:
+        /*!
+         *  @brief Supplies the signal seen by the device at a point in time.
+         *
+         *  @param context The pointer given to setWaveform().
+         *  @param micros Virtual time in microseconds.
+         *  @param microAmps Receives the shunt current (negative for reverse).
+         *  @param microVolts Receives the bus voltage.
+        */
+        typedef void (*Waveform)(void *context, uint64_t micros, int32_t &microAmps, uint32_t &microVolts);
+
+        explicit INA260Model(uint8_t address = INA260_I2CADDR_DEFAULT);
+
+        uint8_t getAddress(void) const;
+        void setWaveform(Waveform waveform, void *context = nullptr);
+        void setConstant(int32_t microAmps, uint32_t microVolts);
+
+        void reset(void);
+        void update(uint64_t now);
+
+        uint16_t readRegister(uint8_t reg);
+        void writeRegister(uint8_t reg, uint16_t value);
+        uint16_t peekRegister(uint8_t reg) const;
+
+        uint8_t getPointer(void) const;
+        void setPointer(uint8_t reg);
+
+        bool isAlertAsserted(void) const;
+        bool getAlertPinLevel(void) const;
+        uint32_t getConversionCount(void) const;
+        uint32_t getAlertEdgeCount(void) const;
+        uint64_t getLastAlertEdgeMicros(void) const;
+
+    private:
+        uint8_t address;
+        uint8_t pointer;
+        Waveform waveform;
+        void *context;
+        int32_t constantMicroAmps;
+        uint32_t constantMicroVolts;
+
+        ConfigurationRegister config;
+        MaskEnableRegister maskEnable;
+        uint16_t current;
+        uint16_t voltage;
+        uint16_t power;
+        uint16_t alertLimit;
+        bool alertAsserted;
+        uint32_t alertEdges;     // Assertions of ALERT, kept across resets
+        uint64_t alertEdgeMicros;
+
+        uint64_t now;
+        uint64_t nextSample;     // End of the sample in progress, 0 when idle
+        uint16_t samplesTaken;
+        int64_t currentSum;
+        int64_t voltageSum;
+        uint32_t conversions;
+
+        uint32_t sampleMicros(void) const;
+        void startConversion(uint64_t at);
+        void completeConversion(void);
+        bool limitExceeded(void) const;
+        void refreshAlert(void);
+};
+
+#endif // INA260Model.H
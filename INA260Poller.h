@@ -0,0 +1,272 @@
+#ifndef INA260Poller_h
+#define INA260Poller_h
+
+#include "INA260.h"
+#include "INA260Clock.h"
+
+/*!
+ *  @brief Samples many INA260s on one bus, each on its own period.
+ *
+ *  Devices are added by address (typically the list filled in by
+ *  INA260Device::findDevices()). Every call to poll() reads current, bus
+ *  voltage and power from each device whose period has elapsed and
+ *  stores the raw values in a preallocated structure-of-arrays buffer,
+ *  indexed by the order the devices were added. The poller also reports
+ *  the sample rate each device achieved and the fraction of time spent
+ *  on the bus.
+*/
+template <class Transport, uint8_t MaxDevices = 16>
+class INA260Poller {
+    public:
+        struct Samples {
+            uint8_t address[MaxDevices];
+            int16_t current[MaxDevices];      // 1.25 mA/LSB
+            uint16_t voltage[MaxDevices];     // 1.25 mV/LSB
+            uint16_t power[MaxDevices];       // 10 mW/LSB
+            uint32_t timestamp[MaxDevices];   // Clock value when the device was sampled
+            uint32_t sampleCount[MaxDevices];
+            uint32_t errorCount[MaxDevices];
+            uint32_t missedCount[MaxDevices]; // Periods skipped because poll() was late, never for period 0
+        };
+
+        explicit INA260Poller(Transport &bus, INA260ClockFunction clock = ina260Micros);
+
+        uint8_t addDevice(uint8_t address, uint32_t periodMicros);
+        uint8_t addDevices(const uint8_t *addresses, int count, uint32_t periodMicros);
+        bool setPeriod(uint8_t index, uint32_t periodMicros);
+        uint8_t getDeviceCount(void) const;
+
+        uint8_t poll(void);
+
+        const Samples &samples(void) const;
+        uint32_t achievedRate(uint8_t index) const;
+        uint16_t busUtilisation(void) const;
+        void resetStatistics(void);
+
+    private:
+        INA260Device<Transport> device;
+        INA260ClockFunction clock;
+        Samples buffer;
+        uint32_t period[MaxDevices];
+        uint32_t due[MaxDevices];
+        uint8_t count;
+        uint32_t lastClock;      // Clock value when elapsed was last brought up to date
+        uint64_t elapsed;        // Microseconds measured, kept in 64 bits past the clock's wrap
+        uint64_t busyMicros;
+
+        uint64_t elapsedMicros(void) const;
+};
+
+/*!
+ *  @brief Instantiates a poller for the devices on one bus.
+ *
+ *  @param bus The transport the devices are connected to.
+ *  @param clock The microsecond clock used for scheduling and statistics.
+*/
+template <class Transport, uint8_t MaxDevices>
+INA260Poller<Transport, MaxDevices>::INA260Poller(Transport &bus, INA260ClockFunction clock) :
+    device(bus),
+    clock(clock),
+    buffer(),
+    period(),
+    due(),
+    count(0),
+    lastClock(clock()),
+    elapsed(0),
+    busyMicros(0) {}
+
+/*!
+ *  @brief Adds a device, due for its first sample immediately.
+ *
+ *  @param address The device address.
+ *  @param periodMicros Time between samples of this device, 0 to
+ *  sample it on every poll().
+ *  @return The device's index in the sample buffer, or MaxDevices if
+ *  the poller is full.
+*/
+template <class Transport, uint8_t MaxDevices>
+uint8_t INA260Poller<Transport, MaxDevices>::addDevice(uint8_t address, uint32_t periodMicros) {
+    if (count >= MaxDevices) {
+        return MaxDevices;
+    }
+    const uint8_t index = count++;
+    buffer.address[index] = address;
+    period[index] = periodMicros;
+    due[index] = clock();
+    return index;
+}
+
+/*!
+ *  @brief Adds a list of devices sharing one period, e.g.
+ *  addDevices(ina260.devices, ina260.deviceCount, 10000).
+ *
+ *  @param addresses The device addresses.
+ *  @param count The number of addresses.
+ *  @param periodMicros Time between samples of each device.
+ *  @return The number of devices added.
+*/
+template <class Transport, uint8_t MaxDevices>
+uint8_t INA260Poller<Transport, MaxDevices>::addDevices(const uint8_t *addresses, int count, uint32_t periodMicros) {
+    uint8_t added = 0;
+    for (int i = 0; i < count; i++) {
+        if (addDevice(addresses[i], periodMicros) == MaxDevices) {
+            break;
+        }
+        added++;
+    }
+    return added;
+}
+
+/*!
+ *  @brief Changes the sampling period of a device.
+ *
+ *  @param index The device's index in the sample buffer.
+ *  @param periodMicros Time between samples of this device, 0 for
+ *  every poll().
+ *  @return True if the device exists, otherwise false.
+*/
+template <class Transport, uint8_t MaxDevices>
+bool INA260Poller<Transport, MaxDevices>::setPeriod(uint8_t index, uint32_t periodMicros) {
+    if (index >= count) {
+        return false;
+    }
+    period[index] = periodMicros;
+    return true;
+}
+
+/*!
+ *  @brief Gets the number of devices being polled.
+ *
+ *  @return The number of devices.
+*/
+template <class Transport, uint8_t MaxDevices>
+uint8_t INA260Poller<Transport, MaxDevices>::getDeviceCount(void) const {
+    return count;
+}
+
+/*!
+ *  @brief Samples every device whose period has elapsed. Call it as
+ *  often as possible; it returns without bus traffic when nothing is due.
+ *
+ *  @return The number of devices sampled.
+*/
+template <class Transport, uint8_t MaxDevices>
+uint8_t INA260Poller<Transport, MaxDevices>::poll(void) {
+    uint8_t sampled = 0;
+    const uint32_t tick = clock();
+    elapsed += tick - lastClock;
+    lastClock = tick;
+    for (uint8_t i = 0; i < count; i++) {
+        const uint32_t now = clock();
+        if (static_cast<int32_t>(now - due[i]) < 0) {
+            continue;
+        }
+
+        device.setAddress(buffer.address[i]);
+        uint16_t current;
+        uint16_t voltage;
+        uint16_t power;
+        const bool ok = device.readRegister(INA260_CURRENT_REGISTER, current) &&
+                        device.readRegister(INA260_VOLTAGE_REGISTER, voltage) &&
+                        device.readRegister(INA260_POWER_REGISTER, power);
+        const uint32_t done = clock();
+        busyMicros += done - now;
+
+        if (ok) {
+            buffer.current[i] = static_cast<int16_t>(current);
+            buffer.voltage[i] = voltage;
+            buffer.power[i] = power;
+            buffer.timestamp[i] = now;
+            buffer.sampleCount[i]++;
+            sampled++;
+        } else {
+            buffer.errorCount[i]++;
+        }
+
+        // Keep to the schedule, but skip periods already missed rather
+        // than bursting to catch up. A period that starts as the read
+        // finishes is not missed.
+        if (period[i] == 0) {
+            continue;
+        }
+        due[i] += period[i];
+        if (static_cast<int32_t>(done - due[i]) > 0) {
+            const uint32_t late = (done - due[i] - 1) / period[i] + 1;
+            buffer.missedCount[i] += late;
+            due[i] += late * period[i];
+        }
+    }
+    return sampled;
+}
+
+/*!
+ *  @brief Gets the sample buffer.
+ *
+ *  @return The structure-of-arrays buffer, indexed by device.
+*/
+template <class Transport, uint8_t MaxDevices>
+const typename INA260Poller<Transport, MaxDevices>::Samples &INA260Poller<Transport, MaxDevices>::samples(void) const {
+    return buffer;
+}
+
+/*!
+ *  @brief Gets the sample rate a device achieved since the poller was
+ *  created or the statistics were reset.
+ *
+ *  @param index The device's index in the sample buffer.
+ *  @return Successful samples per second, in millihertz.
+*/
+template <class Transport, uint8_t MaxDevices>
+uint32_t INA260Poller<Transport, MaxDevices>::achievedRate(uint8_t index) const {
+    const uint64_t micros = elapsedMicros();
+    if (index >= count || micros == 0) {
+        return 0;
+    }
+    return static_cast<uint32_t>(static_cast<uint64_t>(buffer.sampleCount[index]) * 1000000000ULL / micros);
+}
+
+/*!
+ *  @brief Gets the fraction of time spent in bus transactions since the
+ *  poller was created or the statistics were reset.
+ *
+ *  @return Bus utilisation in parts per thousand.
+*/
+template <class Transport, uint8_t MaxDevices>
+uint16_t INA260Poller<Transport, MaxDevices>::busUtilisation(void) const {
+    const uint64_t micros = elapsedMicros();
+    if (micros == 0) {
+        return 0;
+    }
+    return static_cast<uint16_t>(busyMicros * 1000 / micros);
+}
+
+/*!
+ *  @brief Clears the sample, error and missed counters and restarts the
+ *  rate and utilisation measurement.
+*/
+template <class Transport, uint8_t MaxDevices>
+void INA260Poller<Transport, MaxDevices>::resetStatistics(void) {
+    for (uint8_t i = 0; i < count; i++) {
+        buffer.sampleCount[i] = 0;
+        buffer.errorCount[i] = 0;
+        buffer.missedCount[i] = 0;
+    }
+    lastClock = clock();
+    elapsed = 0;
+    busyMicros = 0;
+}
+
+/*!
+ *  @brief Gets the time measured since the poller was created or the
+ *  statistics were reset. poll() folds the 32-bit clock into 64 bits,
+ *  so the measurement survives the clock wrapping (every 71.6 minutes
+ *  for micros()) as long as poll() runs at least once per wrap.
+ *
+ *  @return Elapsed microseconds.
+*/
+template <class Transport, uint8_t MaxDevices>
+uint64_t INA260Poller<Transport, MaxDevices>::elapsedMicros(void) const {
+    return elapsed + static_cast<uint32_t>(clock() - lastClock);
+}
+
+#endif // INA260Poller.H
@@ -0,0 +1,147 @@
+#ifndef INA260SampleRing_h
+#define INA260SampleRing_h
+
+#include <stdint.h>
+
+#include "INA260.h"
+
+#if defined(__AVR__)
+    typedef uint8_t RingIndex;          // Single-byte loads and stores are atomic
+    #define INA260_RING_ALIGN
+#else
+    typedef uint32_t RingIndex;
+    #define INA260_RING_ALIGN __attribute__((aligned(64))) // Keeps producer and consumer off one cache line
+#endif
+
+/*!
+ *  @brief Fixed-capacity single-producer/single-consumer queue of raw
+ *  samples (or any other copyable record T), for handing samples from
+ *  an interrupt or acquisition thread to loop() or a consumer thread
+ *  without disabling interrupts or taking locks.
+ *
+ *  push() and pop() are wait-free. Each side owns its index and only
+ *  reads the other's, with acquire/release ordering. When the ring is
+ *  full push() drops the new sample and counts it, so the consumer
+ *  always sees the oldest data in order.
+ *
+ *  Capacity must be a power of two; on AVR the indices are single bytes
+ *  and Capacity is at most 128.
+*/
+template <RingIndex Capacity, typename T = RawSample>
+class INA260SampleRing {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+    static_assert(Capacity <= static_cast<RingIndex>(~static_cast<RingIndex>(0)) / 2 + 1,
+                  "Capacity does not fit the ring index");
+
+    private:
+        // Producer side
+        INA260_RING_ALIGN RingIndex head;
+        RingIndex tailCache;          // Last tail seen, refreshed only when the ring looks full
+        volatile uint32_t overflows;
+        // Consumer side
+        INA260_RING_ALIGN RingIndex tail;
+        INA260_RING_ALIGN T samples[Capacity];
+
+        static uint32_t readCounter(const volatile uint32_t &counter) {
+            uint32_t value;
+            do {
+                value = counter;
+            } while (value != counter);
+            return value;
+        }
+
+    public:
+        INA260SampleRing(void) :
+            head(0),
+            tailCache(0),
+            overflows(0),
+            tail(0) {}
+
+        /*!
+         *  @brief Appends a sample. Producer only.
+         *
+         *  @param sample The sample.
+         *  @return True if stored, false if the ring was full.
+        */
+        bool push(const T &sample) {
+            const RingIndex h = head;
+            if (static_cast<RingIndex>(h - tailCache) == Capacity) {
+                tailCache = __atomic_load_n(&tail, __ATOMIC_ACQUIRE);
+                if (static_cast<RingIndex>(h - tailCache) == Capacity) {
+                    overflows = overflows + 1;
+                    return false;
+                }
+            }
+            samples[h & (Capacity - 1)] = sample;
+            __atomic_store_n(&head, static_cast<RingIndex>(h + 1), __ATOMIC_RELEASE);
+            return true;
+        }
+
+        /*!
+         *  @brief Reads a snapshot from the device and appends it.
+         *  Producer only, RawSample rings only.
+         *
+         *  @param device The device to read.
+         *  @param micros The sample timestamp.
+         *  @return True if read and stored, otherwise false.
+        */
+        template <class Transport>
+        bool push(INA260Device<Transport> &device, uint32_t micros) {
+            Snapshot snapshot;
+            if (! device.readSnapshot(snapshot)) {
+                return false;
+            }
+            return push(rawSample(snapshot, micros));
+        }
+
+        /*!
+         *  @brief Removes the oldest sample. Consumer only.
+         *
+         *  @param sample Receives the sample.
+         *  @return True if a sample was removed, false if the ring was empty.
+        */
+        bool pop(T &sample) {
+            const RingIndex t = tail;
+            if (__atomic_load_n(&head, __ATOMIC_ACQUIRE) == t) {
+                return false;
+            }
+            sample = samples[t & (Capacity - 1)];
+            __atomic_store_n(&tail, static_cast<RingIndex>(t + 1), __ATOMIC_RELEASE);
+            return true;
+        }
+
+        /*!
+         *  @brief Copies the oldest sample without removing it.
+         *  Consumer only.
+         *
+         *  @param sample Receives the sample.
+         *  @return True if a sample is waiting, false if the ring was empty.
+        */
+        bool peek(T &sample) const {
+            const RingIndex t = tail;
+            if (__atomic_load_n(&head, __ATOMIC_ACQUIRE) == t) {
+                return false;
+            }
+            sample = samples[t & (Capacity - 1)];
+            return true;
+        }
+
+        /*!
+         *  @brief Gets the number of samples waiting. From the consumer
+         *  this is a lower bound, since the producer may push meanwhile;
+         *  from the producer it is an upper bound.
+        */
+        RingIndex size(void) const {
+            return __atomic_load_n(&head, __ATOMIC_ACQUIRE) - __atomic_load_n(&tail, __ATOMIC_ACQUIRE);
+        }
+
+        /*!
+         *  @brief Gets the number of samples dropped because the ring
+         *  was full.
+        */
+        uint32_t getOverflowCount(void) const {
+            return readCounter(overflows);
+        }
+};
+
+#endif // INA260SampleRing.H
@@ -0,0 +1,139 @@
+#ifndef INA260SeqLock_h
+#define INA260SeqLock_h
+
+#include <stdint.h>
+
+#include "INA260.h"
+
+/*!
+ *  @brief A value written by one writer and read by any number of
+ *  readers without locks. The writer never waits; a reader that
+ *  overlaps a write retries, so reads cost a copy and two loads of
+ *  the sequence counter.
+ *
+ *  The sequence counter is odd while a write is in progress. Readers
+ *  must not interrupt the writer on the same core (an interrupt reading
+ *  while loop() writes would spin forever); use tryRead() there.
+*/
+template <typename T>
+class INA260SeqLock {
+    private:
+        unsigned int sequence;
+        T value;
+
+    public:
+        INA260SeqLock(void) :
+            sequence(0),
+            value() {}
+
+        /*!
+         *  @brief Publishes a new value. Writer only.
+         *
+         *  @param update The new value.
+        */
+        void write(const T &update) {
+            const unsigned int s = __atomic_load_n(&sequence, __ATOMIC_RELAXED);
+            __atomic_store_n(&sequence, s + 1, __ATOMIC_RELAXED);
+            __atomic_thread_fence(__ATOMIC_RELEASE);
+            value = update;
+            __atomic_store_n(&sequence, s + 2, __ATOMIC_RELEASE);
+        }
+
+        /*!
+         *  @brief Copies the value unless a write is in progress.
+         *
+         *  @param result Receives the value.
+         *  @return True if a consistent copy was made, otherwise false.
+        */
+        bool tryRead(T &result) const {
+            const unsigned int before = __atomic_load_n(&sequence, __ATOMIC_ACQUIRE);
+            if (before & 1) {
+                return false;
+            }
+            T copy = value;
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            if (__atomic_load_n(&sequence, __ATOMIC_RELAXED) != before) {
+                return false;
+            }
+            result = copy;
+            return true;
+        }
+
+        /*!
+         *  @brief Gets a consistent copy of the value.
+         *
+         *  @return The value.
+        */
+        T read(void) const {
+            T result;
+            while (! tryRead(result)) {
+            }
+            return result;
+        }
+
+        /*!
+         *  @brief Gets the number of writes so far, wrapping. Readers can
+         *  compare it to tell whether anything changed.
+        */
+        unsigned int getVersion(void) const {
+            return __atomic_load_n(&sequence, __ATOMIC_ACQUIRE) / 2;
+        }
+};
+
+/*!
+ *  @brief The most recent sample of a device, published by one
+ *  acquisition thread for any number of readers. Readers get a
+ *  consistent current, voltage and power triple with no bus traffic
+ *  and no locks, so the cost of a read does not grow with the number
+ *  of readers.
+*/
+class INA260LatestSample {
+    private:
+        INA260SeqLock<RawSample> latest;
+
+    public:
+        /*!
+         *  @brief Publishes a sample. Acquisition thread only.
+        */
+        void publish(const RawSample &sample) {
+            latest.write(sample);
+        }
+
+        /*!
+         *  @brief Reads a snapshot from the device and publishes it.
+         *  Acquisition thread only.
+         *
+         *  @param device The device to read.
+         *  @param micros The sample timestamp.
+         *  @return True if read and published, otherwise false.
+        */
+        template <class Transport>
+        bool publish(INA260Device<Transport> &device, uint32_t micros) {
+            Snapshot snapshot;
+            if (! device.readSnapshot(snapshot)) {
+                return false;
+            }
+            latest.write(rawSample(snapshot, micros));
+            return true;
+        }
+
+        /*!
+         *  @brief Gets the latest sample, all zero before the first.
+        */
+        RawSample read(void) const {
+            return latest.read();
+        }
+
+        bool tryRead(RawSample &sample) const {
+            return latest.tryRead(sample);
+        }
+
+        /*!
+         *  @brief Gets the number of samples published, wrapping.
+        */
+        unsigned int getVersion(void) const {
+            return latest.getVersion();
+        }
+};
+
+#endif // INA260SeqLock.H
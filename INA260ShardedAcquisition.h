@@ -0,0 +1,303 @@
+#ifndef INA260ShardedAcquisition_h
+#define INA260ShardedAcquisition_h
+
+#if defined(__linux__) && !defined(ARDUINO)
+
+#include <errno.h>
+#include <new>
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+
+#include "INA260.h"
+#include "INA260Clock.h"
+#include "INA260Poller.h"
+#include "INA260SampleRing.h"
+
+/*!
+ *  @brief A sample in the merged stream of INA260ShardedAcquisition.
+ *  flags is always 0; the poller reads current, voltage and power only.
+*/
+struct BusSample {
+    RawSample sample;
+    uint8_t bus;     // Index returned by addBus()
+    uint8_t address;
+};
+
+/*!
+ *  @brief Acquisition across several I2C buses with one worker thread
+ *  per bus, so every bus is busy at once instead of a single loop
+ *  leaving all but one idle.
+ *
+ *  Each worker runs an INA260Poller over the devices on its bus and
+ *  pushes every new sample into its own INA260SampleRing, so workers
+ *  share nothing. next() merges the rings into one stream, taking the
+ *  oldest waiting sample first; order across buses is by timestamp
+ *  among the samples already delivered. Workers can be pinned to a CPU
+ *  and run at a SCHED_FIFO priority, both set before the thread starts.
+ *  A worker whose priority is refused (no CAP_SYS_NICE) runs at normal
+ *  priority and one whose CPU is not available runs unpinned; check
+ *  isRealtime() and isPinned() after start().
+ *
+ *  Linux only.
+*/
+template <class Transport, uint8_t MaxBuses = 4, uint8_t MaxDevices = 16, RingIndex Capacity = 1024>
+class INA260ShardedAcquisition {
+    private:
+        typedef INA260Poller<Transport, MaxDevices> Poller;
+
+        struct Shard {
+            Poller *poller;
+            INA260SampleRing<Capacity, BusSample> ring;
+            uint32_t seen[MaxDevices];
+            uint8_t index;
+            int cpu;
+            int priority;
+            bool pinned;
+            bool realtime;
+            pthread_t thread;
+            INA260ShardedAcquisition *owner;
+        };
+
+        Shard shards[MaxBuses];
+        alignas(Poller) unsigned char pollers[MaxBuses][sizeof(Poller)]; // Constructed by addBus()
+        uint8_t count;
+        bool running;
+        bool started;
+        uint32_t idleMicros;
+        INA260ClockFunction clock;
+
+        /*!
+         *  @brief Creates a shard's worker with its CPU and priority as
+         *  requested by shard.pinned and shard.realtime.
+         *
+         *  @return 0, or the pthread_create() error.
+        */
+        static int create(Shard &shard) {
+            pthread_attr_t attributes;
+            pthread_attr_init(&attributes);
+            if (shard.pinned) {
+                cpu_set_t cpus;
+                CPU_ZERO(&cpus);
+                CPU_SET(shard.cpu, &cpus);
+                pthread_attr_setaffinity_np(&attributes, sizeof(cpus), &cpus);
+            }
+            if (shard.realtime) {
+                struct sched_param param;
+                param.sched_priority = shard.priority;
+                pthread_attr_setinheritsched(&attributes, PTHREAD_EXPLICIT_SCHED);
+                pthread_attr_setschedpolicy(&attributes, SCHED_FIFO);
+                pthread_attr_setschedparam(&attributes, &param);
+            }
+            const int error = pthread_create(&shard.thread, &attributes, worker, &shard);
+            pthread_attr_destroy(&attributes);
+            return error;
+        }
+
+        static void *worker(void *context) {
+            Shard *shard = static_cast<Shard *>(context);
+            const typename Poller::Samples &samples = shard->poller->samples();
+            while (__atomic_load_n(&shard->owner->running, __ATOMIC_ACQUIRE)) {
+                if (shard->poller->poll() == 0) {
+                    ina260SleepMicros(shard->owner->idleMicros);
+                    continue;
+                }
+                for (uint8_t i = 0; i < shard->poller->getDeviceCount(); i++) {
+                    if (samples.sampleCount[i] == shard->seen[i]) {
+                        continue;
+                    }
+                    shard->seen[i] = samples.sampleCount[i];
+                    const BusSample sample = {
+                        { samples.timestamp[i], static_cast<uint16_t>(samples.current[i]),
+                          samples.voltage[i], samples.power[i], 0 },
+                        shard->index, samples.address[i]
+                    };
+                    shard->ring.push(sample);
+                }
+            }
+            return nullptr;
+        }
+
+    public:
+        /*!
+         *  @brief Instantiates a manager with no buses.
+         *
+         *  @param clock The timestamp source shared by all workers.
+        */
+        explicit INA260ShardedAcquisition(INA260ClockFunction clock = ina260Micros) :
+            count(0),
+            running(false),
+            started(false),
+            idleMicros(100),
+            clock(clock) {}
+
+        ~INA260ShardedAcquisition(void) {
+            stop();
+            for (uint8_t i = 0; i < count; i++) {
+                shards[i].poller->~Poller();
+            }
+        }
+
+        INA260ShardedAcquisition(const INA260ShardedAcquisition &) = delete;
+        INA260ShardedAcquisition &operator=(const INA260ShardedAcquisition &) = delete;
+
+        /*!
+         *  @brief Adds a bus and the devices on it. Call before start().
+         *
+         *  @param bus The bus transport, used only by this bus's worker.
+         *  @param addresses The devices on the bus.
+         *  @param devices The number of addresses.
+         *  @param periodMicros The sample period of every device.
+         *  @param cpu The CPU to pin the worker to, -1 for any. Must be
+         *  below CPU_SETSIZE.
+         *  @param priority The SCHED_FIFO priority, 0 for normal scheduling.
+         *  Must be within sched_get_priority_min/max(SCHED_FIFO).
+         *  @return The bus index, or -1 if full, already started, or the
+         *  cpu or priority is out of range.
+        */
+        int addBus(Transport &bus, const uint8_t *addresses, uint8_t devices, uint32_t periodMicros,
+                   int cpu = -1, int priority = 0) {
+            if (started || count >= MaxBuses) {
+                return -1;
+            }
+            if (cpu < -1 || cpu >= CPU_SETSIZE) {
+                return -1;
+            }
+            if (priority != 0 && (priority < sched_get_priority_min(SCHED_FIFO) ||
+                                  priority > sched_get_priority_max(SCHED_FIFO))) {
+                return -1;
+            }
+            Shard &shard = shards[count];
+            shard.poller = new (&pollers[count]) Poller(bus, clock);
+            shard.poller->addDevices(addresses, devices, periodMicros);
+            for (uint8_t i = 0; i < MaxDevices; i++) {
+                shard.seen[i] = 0;
+            }
+            shard.index = count;
+            shard.cpu = cpu;
+            shard.priority = priority;
+            shard.pinned = false;
+            shard.realtime = false;
+            shard.owner = this;
+            return count++;
+        }
+
+        /*!
+         *  @brief Sets how long an idle worker sleeps when no device is due.
+         *
+         *  @param micros The sleep in microseconds.
+        */
+        void setIdleSleep(uint32_t micros) {
+            idleMicros = micros;
+        }
+
+        /*!
+         *  @brief Starts one worker thread per bus. A worker that cannot
+         *  get its priority or CPU is started without it.
+         *
+         *  @return True if every worker started, otherwise false (and
+         *  none are left running).
+        */
+        bool start(void) {
+            if (started) {
+                return true;
+            }
+            __atomic_store_n(&running, true, __ATOMIC_RELEASE);
+            for (uint8_t i = 0; i < count; i++) {
+                Shard &shard = shards[i];
+                shard.pinned = shard.cpu >= 0;
+                shard.realtime = shard.priority > 0;
+                int error = create(shard);
+                if (error == EPERM && shard.realtime) {
+                    shard.realtime = false;
+                    error = create(shard);
+                }
+                if (error == EINVAL && shard.pinned) {
+                    shard.pinned = false;
+                    error = create(shard);
+                }
+                if (error != 0) {
+                    __atomic_store_n(&running, false, __ATOMIC_RELEASE);
+                    while (i-- > 0) {
+                        pthread_join(shards[i].thread, nullptr);
+                    }
+                    return false;
+                }
+            }
+            started = true;
+            return true;
+        }
+
+        /*!
+         *  @brief Stops and joins the workers. Samples already queued can
+         *  still be read with next().
+        */
+        void stop(void) {
+            if (! started) {
+                return;
+            }
+            __atomic_store_n(&running, false, __ATOMIC_RELEASE);
+            for (uint8_t i = 0; i < count; i++) {
+                pthread_join(shards[i].thread, nullptr);
+            }
+            started = false;
+        }
+
+        /*!
+         *  @brief Gets the oldest waiting sample across all buses. Call
+         *  from one consumer thread.
+         *
+         *  @param sample Receives the sample.
+         *  @return True if a sample was waiting, otherwise false.
+        */
+        bool next(BusSample &sample) {
+            int8_t oldest = -1;
+            BusSample head;
+            for (uint8_t i = 0; i < count; i++) {
+                if (shards[i].ring.peek(head) &&
+                    (oldest < 0 || static_cast<int32_t>(head.sample.micros - sample.sample.micros) < 0)) {
+                    oldest = i;
+                    sample = head;
+                }
+            }
+            return oldest >= 0 && shards[oldest].ring.pop(sample);
+        }
+
+        uint8_t getBusCount(void) const {
+            return count;
+        }
+
+        /*!
+         *  @brief Gets a bus's poller, for its rate and utilisation
+         *  figures. Read them after stop().
+        */
+        const Poller &getPoller(uint8_t bus) const {
+            return *shards[bus].poller;
+        }
+
+        /*!
+         *  @brief Gets the number of samples a bus dropped because the
+         *  consumer fell behind.
+        */
+        uint32_t getOverflowCount(uint8_t bus) const {
+            return shards[bus].ring.getOverflowCount();
+        }
+
+        /*!
+         *  @brief Is the bus's worker running at real-time priority.
+        */
+        bool isRealtime(uint8_t bus) const {
+            return shards[bus].realtime;
+        }
+
+        /*!
+         *  @brief Is the bus's worker pinned to the CPU given to addBus().
+        */
+        bool isPinned(uint8_t bus) const {
+            return shards[bus].pinned;
+        }
+};
+
+#endif // __linux__
+
+#endif // INA260ShardedAcquisition.H
@@ -0,0 +1,235 @@
+#if defined(__linux__) && !defined(ARDUINO)
+
+#include <fcntl.h>
+#include <new>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "INA260SharedMemory.h"
+
+/*!
+ *  @brief Instantiates a publisher.
+ *
+ *  @param name The POSIX shared-memory name, starting with '/'.
+ *  @param capacity Ring slots, a power of two.
+*/
+INA260SharedPublisher::INA260SharedPublisher(const char *name, uint32_t capacity) :
+    capacity(capacity),
+    header(nullptr),
+    ring(nullptr),
+    size(0),
+    inode(0) {
+    strncpy(this->name, name, sizeof(this->name) - 1);
+    this->name[sizeof(this->name) - 1] = '\0';
+}
+
+INA260SharedPublisher::~INA260SharedPublisher(void) {
+    end();
+}
+
+/*!
+ *  @brief Creates the segment and maps it. A segment of the same name
+ *  left by an earlier publisher is unlinked first, not reused: clients
+ *  still attached keep the old mapping, which stops advancing, and
+ *  must attach again to see the new one.
+ *
+ *  @return True if the segment is ready, false if the capacity is not
+ *  a power of two or a system call failed.
+*/
+bool INA260SharedPublisher::begin(void) {
+    if (header != nullptr) {
+        return true;
+    }
+    if (capacity == 0 || (capacity & (capacity - 1)) != 0) {
+        return false;
+    }
+    const size_t length = sizeof(SharedSampleHeader) + capacity * sizeof(RawSample);
+    shm_unlink(name);
+    const int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    void *memory = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && ftruncate(fd, length) == 0) {
+        memory = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (memory == MAP_FAILED) {
+        shm_unlink(name);
+        return false;
+    }
+
+    // The new segment is zero-filled; clients wait for the magic.
+    header = static_cast<SharedSampleHeader *>(memory);
+    new (&header->latest) INA260SeqLock<RawSample>();
+    header->version = INA260_SHM_VERSION;
+    header->capacity = capacity;
+    ring = reinterpret_cast<RawSample *>(header + 1);
+    size = length;
+    inode = info.st_ino;
+    __atomic_store_n(&header->magic, INA260_SHM_MAGIC, __ATOMIC_RELEASE);
+    return true;
+}
+
+/*!
+ *  @brief Unmaps and removes the segment. Clients keep their mapping
+ *  until they call end(); new clients fail to attach. The name is left
+ *  alone if a newer publisher has taken it over.
+*/
+void INA260SharedPublisher::end(void) {
+    if (header != nullptr) {
+        __atomic_store_n(&header->magic, 0, __ATOMIC_RELEASE);
+        munmap(header, size);
+        const int fd = shm_open(name, O_RDONLY, 0);
+        if (fd >= 0) {
+            struct stat info;
+            const bool ours = (fstat(fd, &info) == 0 && info.st_ino == inode);
+            close(fd);
+            if (ours) {
+                shm_unlink(name);
+            }
+        }
+        header = nullptr;
+        ring = nullptr;
+    }
+}
+
+/*!
+ *  @brief Appends a sample to the ring and makes it the latest value.
+ *  Never blocks on clients.
+ *
+ *  @param sample The sample.
+*/
+void INA260SharedPublisher::publish(const RawSample &sample) {
+    const uint64_t count = header->published;
+    // Pairs with the fence in next(): a client that copies this slot
+    // after it starts being overwritten also sees published at count or
+    // later, and discards the copy.
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    ring[count & (capacity - 1)] = sample;
+    __atomic_store_n(&header->published, count + 1, __ATOMIC_RELEASE);
+    header->latest.write(sample);
+}
+
+/*!
+ *  @brief Gets the number of samples published since begin().
+*/
+uint64_t INA260SharedPublisher::getPublishedCount(void) const {
+    return header ? header->published : 0;
+}
+
+/*!
+ *  @brief Instantiates a client.
+ *
+ *  @param name The publisher's shared-memory name.
+*/
+INA260SharedClient::INA260SharedClient(const char *name) :
+    header(nullptr),
+    ring(nullptr),
+    size(0),
+    position(0),
+    lost(0) {
+    strncpy(this->name, name, sizeof(this->name) - 1);
+    this->name[sizeof(this->name) - 1] = '\0';
+}
+
+INA260SharedClient::~INA260SharedClient(void) {
+    end();
+}
+
+/*!
+ *  @brief Maps the publisher's segment read-only. next() starts with the
+ *  first sample published after this call.
+ *
+ *  @return True if attached, false if there is no valid segment.
+*/
+bool INA260SharedClient::begin(void) {
+    if (header != nullptr) {
+        return true;
+    }
+    const int fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    void *memory = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && static_cast<size_t>(info.st_size) >= sizeof(SharedSampleHeader)) {
+        memory = mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (memory == MAP_FAILED) {
+        return false;
+    }
+    const SharedSampleHeader *mapped = static_cast<const SharedSampleHeader *>(memory);
+    if (__atomic_load_n(&mapped->magic, __ATOMIC_ACQUIRE) != INA260_SHM_MAGIC ||
+        mapped->version != INA260_SHM_VERSION ||
+        static_cast<size_t>(info.st_size) < sizeof(SharedSampleHeader) + mapped->capacity * sizeof(RawSample)) {
+        munmap(memory, info.st_size);
+        return false;
+    }
+    header = mapped;
+    ring = reinterpret_cast<const RawSample *>(header + 1);
+    size = info.st_size;
+    position = __atomic_load_n(&header->published, __ATOMIC_ACQUIRE);
+    lost = 0;
+    return true;
+}
+
+/*!
+ *  @brief Unmaps the segment.
+*/
+void INA260SharedClient::end(void) {
+    if (header != nullptr) {
+        munmap(const_cast<SharedSampleHeader *>(header), size);
+        header = nullptr;
+        ring = nullptr;
+    }
+}
+
+/*!
+ *  @brief Gets the next sample in publication order.
+ *
+ *  @param sample Receives the sample.
+ *  @return True if a sample was read, false if none is waiting.
+*/
+bool INA260SharedClient::next(RawSample &sample) {
+    const uint64_t capacity = header->capacity;
+    for (;;) {
+        const uint64_t published = __atomic_load_n(&header->published, __ATOMIC_ACQUIRE);
+        if (position == published) {
+            return false;
+        }
+        // The slot at published - capacity may be being overwritten, so
+        // only capacity - 1 samples are readable.
+        if (published - position >= capacity) {
+            lost += published - position - (capacity - 1);
+            position = published - (capacity - 1);
+        }
+        sample = ring[position & (capacity - 1)];
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&header->published, __ATOMIC_RELAXED) - position < capacity) {
+            position++;
+            return true;
+        }
+    }
+}
+
+/*!
+ *  @brief Gets the most recently published sample, independent of the
+ *  next() position.
+ *
+ *  @param sample Receives the sample.
+ *  @return True if a sample has been published, otherwise false.
+*/
+bool INA260SharedClient::latest(RawSample &sample) const {
+    if (header->latest.getVersion() == 0) {
+        return false;
+    }
+    sample = header->latest.read();
+    return true;
+}
+
+#endif // __linux__
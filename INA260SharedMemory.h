@@ -0,0 +1,145 @@
+#ifndef INA260SharedMemory_h
+#define INA260SharedMemory_h
+
+#include <stdint.h>
+
+#include "INA260.h"
+#include "INA260Clock.h"
+#include "INA260SeqLock.h"
+
+#define INA260_SHM_MAGIC                0x494E4132 // "INA2", written last by the publisher
+#define INA260_SHM_VERSION              1          // Layout version, bumped on incompatible changes
+
+/*!
+ *  @brief Start of the shared-memory segment. The sample ring of
+ *  capacity RawSamples follows it directly.
+*/
+struct __attribute__((aligned(64))) SharedSampleHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t capacity;                 // Ring slots, a power of two
+    uint32_t reserved;
+    uint64_t published;                // Samples written so far; slot is published % capacity
+    INA260SeqLock<RawSample> latest;   // The most recent sample
+};
+
+/*!
+ *  @brief Publishes samples into a POSIX shared-memory segment for any
+ *  number of consumer processes: a ring of the recent samples plus a
+ *  latest-value block. One process (the acquisition daemon) owns the
+ *  bus and the publisher; see INA260SharedClient for the reading side.
+ *
+ *  Linux only.
+*/
+class INA260SharedPublisher {
+    private:
+        char name[32];
+        uint32_t capacity;
+        SharedSampleHeader *header;
+        RawSample *ring;
+        size_t size;
+        uint64_t inode;                // Identifies our segment once the name is reused
+
+    public:
+        explicit INA260SharedPublisher(const char *name = "/ina260", uint32_t capacity = 4096);
+        ~INA260SharedPublisher(void);
+
+        INA260SharedPublisher(const INA260SharedPublisher &) = delete;
+        INA260SharedPublisher &operator=(const INA260SharedPublisher &) = delete;
+
+        bool begin(void);
+        void end(void);
+
+        void publish(const RawSample &sample);
+        uint64_t getPublishedCount(void) const;
+
+        /*!
+         *  @brief Reads a snapshot from the device and publishes it.
+         *
+         *  @param device The device to read.
+         *  @param micros The sample timestamp.
+         *  @return True if read and published, otherwise false.
+        */
+        template <class Transport>
+        bool publish(INA260Device<Transport> &device, uint32_t micros) {
+            Snapshot snapshot;
+            if (! device.readSnapshot(snapshot)) {
+                return false;
+            }
+            publish(rawSample(snapshot, micros));
+            return true;
+        }
+
+        /*!
+         *  @brief The acquisition daemon loop: samples the device every
+         *  periodMicros and publishes each sample until running is
+         *  cleared. A late sample moves the schedule instead of causing
+         *  a burst of catch-up reads.
+         *
+         *  @param device The device to sample.
+         *  @param periodMicros The sample period.
+         *  @param running Cleared (e.g. by a signal handler) to stop.
+         *  @param clock The timestamp source.
+         *  @param sleep How to wait for the next sample.
+         *  @return The number of failed reads.
+        */
+        template <class Transport>
+        uint32_t run(INA260Device<Transport> &device, uint32_t periodMicros, const volatile bool &running,
+                     INA260ClockFunction clock = ina260Micros, INA260SleepFunction sleep = ina260SleepMicros) {
+            uint32_t failures = 0;
+            uint32_t deadline = clock();
+            while (running) {
+                const uint32_t now = clock();
+                const int32_t wait = static_cast<int32_t>(deadline - now);
+                if (wait > 0) {
+                    sleep(wait);
+                } else if (static_cast<uint32_t>(-wait) >= periodMicros) {
+                    deadline = now;
+                }
+                if (! publish(device, clock())) {
+                    failures++;
+                }
+                deadline += periodMicros;
+            }
+            return failures;
+        }
+};
+
+/*!
+ *  @brief Reads the samples of an INA260SharedPublisher from another
+ *  process. Samples are read straight from the read-only mapping: no
+ *  system calls, no locks and nothing the publisher waits on.
+ *
+ *  next() returns every sample in order. A client that falls more than
+ *  the ring capacity behind skips to the oldest sample still available
+ *  and counts the skipped ones in getLostCount().
+ *
+ *  Linux only.
+*/
+class INA260SharedClient {
+    private:
+        char name[32];
+        const SharedSampleHeader *header;
+        const RawSample *ring;
+        size_t size;
+        uint64_t position;
+        uint64_t lost;
+
+    public:
+        explicit INA260SharedClient(const char *name = "/ina260");
+        ~INA260SharedClient(void);
+
+        INA260SharedClient(const INA260SharedClient &) = delete;
+        INA260SharedClient &operator=(const INA260SharedClient &) = delete;
+
+        bool begin(void);
+        void end(void);
+
+        bool next(RawSample &sample);
+        bool latest(RawSample &sample) const;
+
+        uint64_t getPosition(void) const { return position; }
+        uint64_t getLostCount(void) const { return lost; }
+};
+
+#endif // INA260SharedMemory.H
@@ -0,0 +1,137 @@
+#ifndef INA260Static_h
+#define INA260Static_h
+
+#include "INA260.h"
+
+/*!
+ *  @brief An INA260 whose address and configuration are fixed at build
+ *  time, for fixed-function boards on flash-constrained targets.
+ *
+ *  The ConfigurationRegister value and the sample period are compile-time
+ *  constants, begin() is a single constant register write and reads go
+ *  straight to the transport with a constant address. There is no
+ *  runtime configuration, shadow state or error bookkeeping; use
+ *  INA260Device when those are needed.
+ *
+ *  When MinRateHz is not 0, compilation fails unless the configuration
+ *  produces at least MinRateHz results per second.
+*/
+template <class Transport, Address Addr, Mode M, AveragingCount Avg,
+          ConversionTime Ishct, ConversionTime Vbusct, uint32_t MinRateHz = 0>
+class INA260StaticDevice {
+    public:
+        static constexpr uint8_t address = Addr;
+        static constexpr uint16_t configuration =
+            (INA260_CONFIG_DEFAULT & 0x7000) | (Avg << 9) | (Vbusct << 6) | (Ishct << 3) | M; // Reserved bits as at reset
+        static constexpr uint32_t periodMicros =
+            static_cast<uint32_t>(((M & MODE_TRIG_ISH) ? conversionTimeMicros(Ishct) : 0) +
+                                  ((M & MODE_TRIG_VBUS) ? conversionTimeMicros(Vbusct) : 0)) *
+            averagingSamples(Avg);
+
+        static_assert(Addr >= ADDRESS_0x40 && Addr <= ADDRESS_0x4F,
+                      "INA260 addresses are 0x40 to 0x4F");
+        static_assert(MinRateHz == 0 || (M & (MODE_TRIG_ISH | MODE_TRIG_VBUS)) != 0,
+                      "a power-down mode produces no samples");
+        static_assert(MinRateHz == 0 || static_cast<uint64_t>(periodMicros) * MinRateHz <= 1000000,
+                      "the conversion times and averaging count are too slow for MinRateHz");
+
+    private:
+        Transport *bus;
+
+    public:
+        /*!
+         *  @brief Instantiates a device on the transport's default bus.
+        */
+        INA260StaticDevice(void) : bus(&Transport::defaultInstance()) {}
+
+        /*!
+         *  @brief Instantiates a device on the given bus.
+         *
+         *  @param bus The transport the device is connected to.
+        */
+        explicit INA260StaticDevice(Transport &bus) : bus(&bus) {}
+
+        /*!
+         *  @brief Starts the bus and writes the configuration.
+         *
+         *  @return True if successful, otherwise false.
+         *
+         *  @note The device is not reset, so alert settings made before
+         *  a processor reset survive.
+        */
+        bool begin(void) {
+            return bus->begin() && writeRegister(INA260_CONFIG_REGISTER, configuration);
+        }
+
+        /*!
+         *  @brief Reads a register.
+         *
+         *  @param reg The register to read.
+         *  @param value Receives the value, untouched on failure.
+         *  @return True if read was successfull, otherwise false.
+        */
+        bool readRegister(uint8_t reg, uint16_t &value) {
+            uint8_t data[2];
+            if (! bus->writeRead(address, &reg, 1, data, 2)) {
+                return false;
+            }
+            value = (static_cast<uint16_t>(data[0]) << 8) | data[1];
+            return true;
+        }
+
+        /*!
+         *  @brief Writes a register.
+         *
+         *  @return True if write was successfull, otherwise false.
+        */
+        bool writeRegister(uint8_t reg, uint16_t value) {
+            const uint8_t data[3] = { reg, static_cast<uint8_t>(value >> 8), static_cast<uint8_t>(value) };
+            return bus->write(address, data, 3);
+        }
+
+        /*!
+         *  @brief Triggers a conversion in a triggered mode.
+         *
+         *  @return True if write was successfull, otherwise false.
+        */
+        bool trigger(void) {
+            return writeRegister(INA260_CONFIG_REGISTER, configuration);
+        }
+
+        /*!
+         *  @brief Reads the current in microamps, 0 on failure.
+        */
+        int32_t readCurrentMicroAmps(void) {
+            uint16_t raw = 0;
+            readRegister(INA260_CURRENT_REGISTER, raw);
+            return currentMicroAmps(raw);
+        }
+
+        /*!
+         *  @brief Reads the bus voltage in microvolts, 0 on failure.
+        */
+        uint32_t readBusVoltageMicroVolts(void) {
+            uint16_t raw = 0;
+            readRegister(INA260_VOLTAGE_REGISTER, raw);
+            return busVoltageMicroVolts(raw);
+        }
+
+        /*!
+         *  @brief Reads the power in microwatts, 0 on failure.
+        */
+        uint32_t readPowerMicroWatts(void) {
+            uint16_t raw = 0;
+            readRegister(INA260_POWER_REGISTER, raw);
+            return powerMicroWatts(raw);
+        }
+};
+
+#ifdef ARDUINO
+    // INA260Static<ADDRESS_0x40, MODE_CONT_ISH_VBUS, AVG_64, TIME_1_1_ms, TIME_1_1_ms>
+    // on the global Wire bus.
+    template <Address Addr, Mode M, AveragingCount Avg,
+              ConversionTime Ishct, ConversionTime Vbusct, uint32_t MinRateHz = 0>
+    using INA260Static = INA260StaticDevice<WireTransport, Addr, M, Avg, Ishct, Vbusct, MinRateHz>;
+#endif
+
+#endif // INA260Static.H
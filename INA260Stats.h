@@ -0,0 +1,288 @@
+#ifndef INA260Stats_h
+#define INA260Stats_h
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "INA260Clock.h"
+
+/*
+ *  Bus transaction instrumentation for INA260Device.
+ *
+ *  Define INA260_ENABLE_STATS before including INA260.h to count the
+ *  transactions, bytes, errors and latency of every register access and
+ *  attribute them to the public call that caused them. Without it the
+ *  INA260_STATS_* hooks expand to nothing, the driver is unchanged and
+ *  none of the types below are declared. Enabled, each device carries
+ *  about 2 kB of counters, which is more than an AVR can usually spare.
+*/
+
+#ifdef INA260_ENABLE_STATS
+
+#define INA260_STATS_REGISTERS          11 // 0x00-0x07, 0xFE, 0xFF, other
+#define INA260_STATS_BUCKETS            16 // Latency histogram buckets, powers of two in us
+
+typedef enum _api {
+    API_NONE = 0,                       // Direct readRegister()/writeRegister() calls
+    API_BEGIN,
+    API_RESET,
+    API_FIND_DEVICES,
+    API_SCAN_DEVICES,
+    API_RESYNC,
+    API_READ_CONFIGURATION,
+    API_WRITE_CONFIGURATION,
+    API_CONFIGURE,
+    API_READ_CURRENT,
+    API_READ_BUS_VOLTAGE,
+    API_READ_POWER,
+    API_READ_SNAPSHOT,
+    API_MEASURE_ONCE,
+    API_READ_MASK_ENABLE,
+    API_WRITE_MASK_ENABLE,
+    API_READ_ALERT_LIMIT,
+    API_WRITE_ALERT_LIMIT,
+    API_ENABLE_OVER_CURRENT_ALERT,
+    API_ENABLE_UNDER_CURRENT_ALERT,
+    API_ENABLE_BUS_OVER_ALERT,
+    API_ENABLE_BUS_UNDER_ALERT,
+    API_ENABLE_OVER_POWER_ALERT,
+    API_SET_CURRENT_LIMIT,
+    API_SET_BUS_VOLTAGE_LIMIT,
+    API_SET_POWER_LIMIT,
+    API_IS_MATH_OVERFLOW,
+    API_IS_ALERT,
+    API_CLEAR_ALERT,
+    API_IS_ALERT_POLARITY_SET,
+    API_SET_ALERT_POLARITY,
+    API_IS_ALERT_LATCH_SET,
+    API_SET_ALERT_LATCH,
+    API_GET_MODE,
+    API_SET_MODE,
+    API_IS_CONVERSION_READY,
+    API_SET_CONVERSION_READY_ALERT,
+    API_GET_CURRENT_CONVERSION_TIME,
+    API_SET_CURRENT_CONVERSION_TIME,
+    API_GET_VOLTAGE_CONVERSION_TIME,
+    API_SET_VOLTAGE_CONVERSION_TIME,
+    API_GET_AVERAGING_COUNT,
+    API_SET_AVERAGING_COUNT,
+    API_READ_MANUFACTURER_ID,
+    API_READ_DIE_ID,
+    API_COUNT
+} Api;
+
+/*!
+ *  @brief Bus traffic for one register.
+*/
+struct RegisterStats {
+    uint32_t reads;       // Reads that sent the register pointer
+    uint32_t cachedReads; // Reads that reused the cached pointer
+    uint32_t writes;
+    uint32_t bytes;       // Bytes on the wire, excluding address bytes
+    uint32_t errors;
+    uint32_t latency[INA260_STATS_BUCKETS]; // Bucket n counts latencies below 2^n us
+};
+
+/*!
+ *  @brief Bus traffic caused by one public call.
+*/
+struct ApiStats {
+    uint32_t calls;
+    uint32_t transactions;
+    uint32_t maxTransactions; // Most transactions made by a single call
+    uint32_t bytes;       // Bytes on the wire, excluding address bytes
+    uint32_t errors;
+    uint32_t maxMicros;   // Longest call
+    uint64_t totalMicros; // Time spent in the call, for the mean
+};
+
+/*!
+ *  @brief All statistics kept by one INA260Device.
+*/
+struct INA260Stats {
+    RegisterStats registers[INA260_STATS_REGISTERS];
+    ApiStats apis[API_COUNT];
+    uint32_t probes;
+    Api current; // Outermost public call in progress
+
+    INA260Stats(void) {
+        reset();
+    }
+
+    /*!
+     *  @brief Clears all counters.
+    */
+    void reset(void) {
+        memset(this, 0, sizeof(*this));
+    }
+
+    /*!
+     *  @brief Maps a register address to its slot in registers[].
+    */
+    static uint8_t slot(uint8_t reg) {
+        if (reg <= INA260_ALERT_LIMIT_REGISTER) {
+            return reg;
+        }
+        if (reg == INA260_MANUFACTURER_ID_REGISTER) {
+            return 8;
+        }
+        return (reg == INA260_DIE_ID_REGISTER) ? 9 : 10;
+    }
+
+    /*!
+     *  @brief Records one register transaction.
+     *
+     *  @param reg The register accessed.
+     *  @param write True for a write, false for a read.
+     *  @param cached True for a read that skipped the pointer write.
+     *  @param ok True if the transaction succeeded.
+     *  @param micros The time the transaction took.
+    */
+    void record(uint8_t reg, bool write, bool cached, bool ok, uint32_t micros) {
+        RegisterStats &r = registers[slot(reg)];
+        const uint8_t bytes = cached ? 2 : 3;
+        if (write) {
+            r.writes++;
+        } else if (cached) {
+            r.cachedReads++;
+        } else {
+            r.reads++;
+        }
+        r.bytes += bytes;
+        uint8_t bucket = 0;
+        while (bucket < INA260_STATS_BUCKETS - 1 && (micros >> bucket) != 0) {
+            bucket++;
+        }
+        r.latency[bucket]++;
+        apis[current].transactions++;
+        apis[current].bytes += bytes;
+        if (! ok) {
+            r.errors++;
+            apis[current].errors++;
+        }
+    }
+
+    /*!
+     *  @brief Gets the printable name of a public call.
+    */
+    static const char *apiName(Api api) {
+        static const char *const names[API_COUNT] = {
+            "(direct)", "begin", "reset", "findDevices", "scanDevices", "resync",
+            "readConfigurationRegister", "writeConfigurationRegister", "configure",
+            "readCurrent", "readBusVoltage", "readPower", "readSnapshot", "measureOnce",
+            "readMaskEnableRegister", "writeMaskEnableRegister",
+            "readAlertLimitRegister", "writeAlertLimitRegister",
+            "enableOverCurrentLimitAlert", "enableUnderCurrentLimitAlert",
+            "enableBusOvertLimitAlert", "enableBusUnderLimitAlert", "enableOverPowerLimitAlert",
+            "setCurrentLimit", "setBusVoltageLimit", "setPowerLimit",
+            "isMathOverFlow", "isAlert", "clearAlert",
+            "isAlertPolaritySet", "setAlertPolarity", "isAlertLatchSet", "setAlertLatch",
+            "getMode", "setMode", "isConversionRready", "setConversionReadyAlert",
+            "getCurrentConversionTime", "setCurrentConversionTime",
+            "getVoltageConversionTime", "setVoltageConversionTime",
+            "getAveragingCount", "setAveragingCount",
+            "readManufactuerId", "readDieId"
+        };
+        return (api < API_COUNT) ? names[api] : "?";
+    }
+
+    /*!
+     *  @brief Writes a human readable report, one line at a time.
+     *
+     *  @param write Called with each line (without newline).
+     *  @param context Passed to write unchanged.
+    */
+    void dump(void (*write)(const char *line, void *context), void *context = nullptr) const {
+        static const uint8_t regs[INA260_STATS_REGISTERS] = {
+            0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0xFE, 0xFF, 0x00
+        };
+        char line[112];
+        write("reg   reads cached writes  bytes errors  latency(us)<2^n:count", context);
+        for (uint8_t i = 0; i < INA260_STATS_REGISTERS; i++) {
+            const RegisterStats &r = registers[i];
+            if (r.reads + r.cachedReads + r.writes == 0) {
+                continue;
+            }
+            int n = snprintf(line, sizeof(line), "%s%02X %6lu %6lu %6lu %6lu %6lu ",
+                             (i == INA260_STATS_REGISTERS - 1) ? "?" : "0x", regs[i],
+                             (unsigned long)r.reads, (unsigned long)r.cachedReads,
+                             (unsigned long)r.writes, (unsigned long)r.bytes,
+                             (unsigned long)r.errors);
+            for (uint8_t b = 0; b < INA260_STATS_BUCKETS && n > 0 && n < (int)sizeof(line); b++) {
+                if (r.latency[b] != 0) {
+                    n += snprintf(line + n, sizeof(line) - n, " %u:%lu", b, (unsigned long)r.latency[b]);
+                }
+            }
+            write(line, context);
+        }
+        write("call                          calls transactions  bytes errors mean(us)  max(us)", context);
+        for (uint8_t i = 0; i < API_COUNT; i++) {
+            const ApiStats &a = apis[i];
+            if (a.calls == 0 && a.transactions == 0) {
+                continue;
+            }
+            snprintf(line, sizeof(line), "%-28s %6lu %12lu %6lu %6lu %8lu %8lu", apiName(static_cast<Api>(i)),
+                     (unsigned long)a.calls, (unsigned long)a.transactions, (unsigned long)a.bytes,
+                     (unsigned long)a.errors, (unsigned long)(a.calls ? a.totalMicros / a.calls : 0),
+                     (unsigned long)a.maxMicros);
+            write(line, context);
+        }
+    }
+};
+
+/*!
+ *  @brief Attributes the transactions made while it is in scope, and the
+ *  time it is in scope, to a public call. Nested calls are charged to
+ *  the outermost one.
+*/
+class INA260StatsScope {
+    private:
+        INA260Stats &stats;
+        bool outermost;
+        uint32_t start;
+        uint32_t transactions; // The call's counter when it started
+
+    public:
+        INA260StatsScope(INA260Stats &stats, Api api) :
+            stats(stats),
+            outermost(stats.current == API_NONE),
+            start(0),
+            transactions(0) {
+            if (outermost) {
+                stats.current = api;
+                stats.apis[api].calls++;
+                transactions = stats.apis[api].transactions;
+                start = ina260Micros();
+            }
+        }
+
+        ~INA260StatsScope(void) {
+            if (outermost) {
+                const uint32_t micros = ina260Micros() - start;
+                ApiStats &a = stats.apis[stats.current];
+                a.totalMicros += micros;
+                if (micros > a.maxMicros) {
+                    a.maxMicros = micros;
+                }
+                if (a.transactions - transactions > a.maxTransactions) {
+                    a.maxTransactions = a.transactions - transactions;
+                }
+                stats.current = API_NONE;
+            }
+        }
+};
+
+    #define INA260_STATS_API(api)           INA260StatsScope statsScope(stats, api)
+    #define INA260_STATS_START()            const uint32_t statsStart = ina260Micros()
+    #define INA260_STATS_RECORD(reg, write, cached, ok) \
+        stats.record(reg, write, cached, ok, ina260Micros() - statsStart)
+    #define INA260_STATS_PROBE()            stats.probes++
+#else
+    #define INA260_STATS_API(api)
+    #define INA260_STATS_START()
+    #define INA260_STATS_RECORD(reg, write, cached, ok)
+    #define INA260_STATS_PROBE()
+#endif
+
+#endif // INA260Stats.H
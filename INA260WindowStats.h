@@ -0,0 +1,218 @@
+#ifndef INA260WindowStats_h
+#define INA260WindowStats_h
+
+#include <math.h>
+#include <stdint.h>
+
+#define INA260_WINDOW_MAX               65535 // Largest window keeping the sums exact
+
+/*!
+ *  @brief Summary of one window of register values, as exact integers.
+ *
+ *  The inputs are raw register values: the signed Current register and
+ *  the unsigned Bus Voltage and Power registers, all within +/-65535.
+ *  With at most INA260_WINDOW_MAX samples the sums and the variance
+ *  numerator below fit 64 bits exactly, so the integer sums take the
+ *  place of Welford's update without its rounding. Send the record as
+ *  is and scale on the receiving side, or use the helpers.
+*/
+struct WindowSummary {
+    uint16_t count;
+    int32_t min;
+    int32_t max;
+    int64_t sum;
+    uint64_t sumSquares;
+
+    /*!
+     *  @brief Gets count^2 x variance, exact.
+    */
+    uint64_t varianceNumerator(void) const {
+        const uint64_t magnitude = (sum < 0) ? -sum : sum;
+        return count * sumSquares - magnitude * magnitude;
+    }
+
+    double mean(void) const {
+        return count ? static_cast<double>(sum) / count : 0.0;
+    }
+
+    double variance(void) const {
+        return count ? static_cast<double>(varianceNumerator()) / (static_cast<double>(count) * count) : 0.0;
+    }
+
+    double standardDeviation(void) const {
+        return sqrt(variance());
+    }
+
+    double rms(void) const {
+        return count ? sqrt(static_cast<double>(sumSquares) / count) : 0.0;
+    }
+};
+
+/*!
+ *  @brief Tumbling window statistics: consecutive, non-overlapping
+ *  windows of a fixed number of samples, or closed by the caller (for
+ *  example once a second). O(1) per sample and no sample storage.
+*/
+class INA260TumblingStats {
+    private:
+        uint16_t size;
+        WindowSummary window;
+
+    public:
+        /*!
+         *  @brief Instantiates a tumbling window.
+         *
+         *  @param size Samples per window, 1 to INA260_WINDOW_MAX; with
+         *  INA260_WINDOW_MAX windows only close when full or by close().
+        */
+        explicit INA260TumblingStats(uint16_t size = INA260_WINDOW_MAX) :
+            size(size ? size : 1),
+            window() {}
+
+        /*!
+         *  @brief Adds a sample, closing the window when it is full.
+         *
+         *  @param value The register value.
+         *  @param closed Receives the window when this sample completes it.
+         *  @return True if a window was completed, otherwise false.
+        */
+        bool add(int32_t value, WindowSummary &closed) {
+            if (window.count == 0 || value < window.min) {
+                window.min = value;
+            }
+            if (window.count == 0 || value > window.max) {
+                window.max = value;
+            }
+            window.sum += value;
+            window.sumSquares += static_cast<uint64_t>(static_cast<int64_t>(value) * value);
+            window.count++;
+            return (window.count >= size) && close(closed);
+        }
+
+        /*!
+         *  @brief Closes the window early, e.g. on a time boundary.
+         *
+         *  @param closed Receives the window.
+         *  @return True if the window held samples, otherwise false.
+        */
+        bool close(WindowSummary &closed) {
+            if (window.count == 0) {
+                return false;
+            }
+            closed = window;
+            window = WindowSummary();
+            return true;
+        }
+
+        /*!
+         *  @brief Gets the window being filled.
+        */
+        const WindowSummary &current(void) const {
+            return window;
+        }
+};
+
+/*!
+ *  @brief Sliding window statistics over the last Size samples.
+ *
+ *  Sums are updated by adding the new sample and subtracting the one
+ *  leaving the window. Minimum and maximum use monotonic queues, so an
+ *  update is amortised O(1) and summary() is O(1). Memory is 8 bytes
+ *  per sample of window.
+*/
+template <uint16_t Size>
+class INA260SlidingStats {
+    static_assert(Size > 0, "the window needs at least one sample");
+
+    private:
+        int32_t samples[Size];
+        uint16_t minQueue[Size]; // Positions in samples, values increasing
+        uint16_t maxQueue[Size]; // Positions in samples, values decreasing
+        uint16_t head;           // Next position to write
+        uint16_t count;
+        uint16_t minFirst;
+        uint16_t minCount;
+        uint16_t maxFirst;
+        uint16_t maxCount;
+        int64_t sum;
+        uint64_t sumSquares;
+
+        static uint16_t wrap(uint32_t position) {
+            return position % Size;
+        }
+
+    public:
+        INA260SlidingStats(void) {
+            reset();
+        }
+
+        /*!
+         *  @brief Empties the window.
+        */
+        void reset(void) {
+            head = 0;
+            count = 0;
+            minFirst = minCount = 0;
+            maxFirst = maxCount = 0;
+            sum = 0;
+            sumSquares = 0;
+        }
+
+        /*!
+         *  @brief Adds a sample, dropping the oldest once the window is full.
+         *
+         *  @param value The register value.
+        */
+        void add(int32_t value) {
+            if (count == Size) {
+                const int32_t old = samples[head];
+                sum -= old;
+                sumSquares -= static_cast<uint64_t>(static_cast<int64_t>(old) * old);
+                if (minCount && minQueue[minFirst] == head) {
+                    minFirst = wrap(minFirst + 1);
+                    minCount--;
+                }
+                if (maxCount && maxQueue[maxFirst] == head) {
+                    maxFirst = wrap(maxFirst + 1);
+                    maxCount--;
+                }
+            } else {
+                count++;
+            }
+            samples[head] = value;
+            sum += value;
+            sumSquares += static_cast<uint64_t>(static_cast<int64_t>(value) * value);
+
+            while (minCount && samples[minQueue[wrap(minFirst + minCount - 1)]] >= value) {
+                minCount--;
+            }
+            minQueue[wrap(minFirst + minCount)] = head;
+            minCount++;
+            while (maxCount && samples[maxQueue[wrap(maxFirst + maxCount - 1)]] <= value) {
+                maxCount--;
+            }
+            maxQueue[wrap(maxFirst + maxCount)] = head;
+            maxCount++;
+
+            head = wrap(head + 1);
+        }
+
+        /*!
+         *  @brief Gets the statistics of the samples in the window.
+         *
+         *  @return The summary, all zero while the window is empty.
+        */
+        WindowSummary summary(void) const {
+            WindowSummary result = WindowSummary();
+            if (count) {
+                result.count = count;
+                result.min = samples[minQueue[minFirst]];
+                result.max = samples[maxQueue[maxFirst]];
+                result.sum = sum;
+                result.sumSquares = sumSquares;
+            }
+            return result;
+        }
+};
+
+#endif // INA260WindowStats.H
@@ -0,0 +1,94 @@
+#if defined(__linux__) && !defined(ARDUINO)
+
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/gpio.h>
+
+#include "LinuxGpioAlertPin.h"
+
+/*!
+ *  @brief Instantiates a pin source for one GPIO line.
+ *
+ *  @param chipNumber The N of /dev/gpiochipN.
+ *  @param line The line offset on the chip wired to ALERT.
+ *  @param activeHigh True if the Alert Polarity bit is set (ALERT rises),
+ *  false for the default active-low ALERT.
+*/
+LinuxGpioAlertPin::LinuxGpioAlertPin(int chipNumber, uint32_t line, bool activeHigh) :
+    line(line),
+    activeHigh(activeHigh),
+    fd(-1),
+    handler(nullptr),
+    context(nullptr) {
+    snprintf(path, sizeof(path), "/dev/gpiochip%d", chipNumber);
+}
+
+LinuxGpioAlertPin::~LinuxGpioAlertPin(void) {
+    end();
+}
+
+/*!
+ *  @brief Requests edge events for the line.
+ *
+ *  @return True if the line was requested, otherwise false.
+*/
+bool LinuxGpioAlertPin::begin(AlertHandler handler, void *context) {
+    end();
+    const int chip = open(path, O_RDONLY);
+    if (chip < 0) {
+        return false;
+    }
+    struct gpioevent_request request;
+    memset(&request, 0, sizeof(request));
+    request.lineoffset = line;
+    request.handleflags = GPIOHANDLE_REQUEST_INPUT;
+    request.eventflags = activeHigh ? GPIOEVENT_REQUEST_RISING_EDGE : GPIOEVENT_REQUEST_FALLING_EDGE;
+    strncpy(request.consumer_label, "ina260-alert", sizeof(request.consumer_label) - 1);
+    const int result = ioctl(chip, GPIO_GET_LINEEVENT_IOCTL, &request);
+    close(chip);
+    if (result < 0) {
+        return false;
+    }
+    fd = request.fd;
+    this->handler = handler;
+    this->context = context;
+    return true;
+}
+
+/*!
+ *  @brief Releases the line.
+*/
+void LinuxGpioAlertPin::end(void) {
+    if (fd >= 0) {
+        close(fd);
+        fd = -1;
+    }
+}
+
+/*!
+ *  @brief Waits up to timeoutMicros for edges and delivers every pending
+ *  edge to the handler.
+ *
+ *  @param timeoutMicros Longest time to wait, 0 to only check.
+*/
+void LinuxGpioAlertPin::service(uint32_t timeoutMicros) {
+    if (fd < 0) {
+        return;
+    }
+    struct pollfd pfd = { fd, POLLIN, 0 };
+    int timeout = static_cast<int>((timeoutMicros + 999) / 1000);
+    while (poll(&pfd, 1, timeout) > 0 && (pfd.revents & POLLIN)) {
+        struct gpioevent_data event;
+        if (read(fd, &event, sizeof(event)) != sizeof(event)) {
+            break;
+        }
+        handler(context, static_cast<uint32_t>(event.timestamp / 1000));
+        timeout = 0;
+    }
+}
+
+#endif // __linux__
@@ -0,0 +1,38 @@
+#ifndef LinuxGpioAlertPin_h
+#define LinuxGpioAlertPin_h
+
+#include <stdint.h>
+
+#include "INA260Alert.h"
+
+/*!
+ *  @brief ALERT pin source using the Linux GPIO character device
+ *  (/dev/gpiochipN) edge events.
+ *
+ *  User space has no interrupts, so edges are delivered from service(),
+ *  which waits on the event file descriptor. Event timestamps are taken
+ *  by the kernel on CLOCK_MONOTONIC (Linux 5.7 and later), the same
+ *  clock as ina260Micros().
+*/
+class LinuxGpioAlertPin {
+    private:
+        char path[32];
+        uint32_t line;
+        bool activeHigh;
+        int fd;
+        AlertHandler handler;
+        void *context;
+
+    public:
+        LinuxGpioAlertPin(int chipNumber, uint32_t line, bool activeHigh = false);
+        ~LinuxGpioAlertPin(void);
+
+        LinuxGpioAlertPin(const LinuxGpioAlertPin &) = delete;
+        LinuxGpioAlertPin &operator=(const LinuxGpioAlertPin &) = delete;
+
+        bool begin(AlertHandler handler, void *context);
+        void end(void);
+        void service(uint32_t timeoutMicros);
+};
+
+#endif // LinuxGpioAlertPin.H
@@ -0,0 +1,194 @@
+#if defined(__linux__) && !defined(ARDUINO)
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+#include "LinuxI2cTransport.h"
+
+/*!
+ *  @brief Instantiates a transport for /dev/i2c-<busNumber>.
+ *
+ *  @param busNumber The adapter number.
+*/
+LinuxI2cTransport::LinuxI2cTransport(int busNumber) : fd(-1), selected(-1), syscalls(0), transfer(TRANSFER_IDLE) {
+    snprintf(path, sizeof(path), "/dev/i2c-%d", busNumber);
+}
+
+/*!
+ *  @brief Instantiates a transport for an explicit i2c-dev path.
+ *
+ *  @param devicePath Path to the i2c-dev character device.
+*/
+LinuxI2cTransport::LinuxI2cTransport(const char *devicePath) : fd(-1), selected(-1), syscalls(0), transfer(TRANSFER_IDLE) {
+    strncpy(path, devicePath, sizeof(path) - 1);
+    path[sizeof(path) - 1] = '\0';
+}
+
+LinuxI2cTransport::~LinuxI2cTransport(void) {
+    end();
+}
+
+/*!
+ *  @brief Opens the i2c-dev device. Safe to call more than once.
+ *
+ *  @return True if the device is open.
+*/
+bool LinuxI2cTransport::begin(void) {
+    if (fd < 0) {
+        fd = open(path, O_RDWR);
+        syscalls++;
+        selected = -1;
+    }
+    return (fd >= 0);
+}
+
+/*!
+ *  @brief Closes the i2c-dev device.
+*/
+void LinuxI2cTransport::end(void) {
+    if (fd >= 0) {
+        close(fd);
+        fd = -1;
+    }
+}
+
+/*!
+ *  @brief Points the file descriptor at a slave address. The kernel
+ *  keeps the address, so the ioctl is only issued when it changes.
+ *
+ *  @return True if the address is selected.
+*/
+bool LinuxI2cTransport::select(uint8_t address) {
+    if (selected == address) {
+        return true;
+    }
+    if (fd < 0) {
+        return false;
+    }
+    syscalls++;
+    if (ioctl(fd, I2C_SLAVE, address) < 0) {
+        selected = -1;
+        return false;
+    }
+    selected = address;
+    return true;
+}
+
+/*!
+ *  @brief Checks whether a device acknowledges the address using a
+ *  zero-length write.
+ *
+ *  @param address The 7-bit device address.
+ *  @return True if the device acknowledged, otherwise false.
+*/
+bool LinuxI2cTransport::probe(uint8_t address) {
+    if (fd < 0) {
+        return false;
+    }
+    struct i2c_msg msg = { address, 0, 0, nullptr };
+    struct i2c_rdwr_ioctl_data xfer = { &msg, 1 };
+    syscalls++;
+    return (ioctl(fd, I2C_RDWR, &xfer) >= 0);
+}
+
+/*!
+ *  @brief Writes bytes to the device in a single transaction.
+ *
+ *  @return True if write was successfull, otherwise false.
+*/
+bool LinuxI2cTransport::write(uint8_t address, const uint8_t *data, uint8_t length) {
+    if (! select(address)) {
+        return false;
+    }
+    syscalls++;
+    const bool ok = (::write(fd, data, length) == length);
+    registerPointers.wrote(address, data, length, ok);
+    return ok;
+}
+
+/*!
+ *  @brief Reads bytes from the device in a single transaction.
+ *
+ *  @return True if all bytes were received, otherwise false.
+*/
+bool LinuxI2cTransport::read(uint8_t address, uint8_t *data, uint8_t length) {
+    if (! select(address)) {
+        return false;
+    }
+    syscalls++;
+    const bool ok = (::read(fd, data, length) == length);
+    registerPointers.read(address, ok);
+    return ok;
+}
+
+/*!
+ *  @brief Writes bytes then reads bytes as one combined transaction
+ *  with a repeated start, issued as a single I2C_RDWR ioctl.
+ *
+ *  @return True if the transfer completed, otherwise false.
+*/
+bool LinuxI2cTransport::writeRead(uint8_t address, const uint8_t *out, uint8_t outLength,
+                                  uint8_t *in, uint8_t inLength) {
+    if (fd < 0) {
+        return false;
+    }
+    struct i2c_msg msgs[2] = {
+        { address, 0, outLength, const_cast<uint8_t *>(out) },
+        { address, I2C_M_RD, inLength, in }
+    };
+    struct i2c_rdwr_ioctl_data xfer = { msgs, 2 };
+    syscalls++;
+    const bool ok = (ioctl(fd, I2C_RDWR, &xfer) == 2);
+    registerPointers.wrote(address, out, outLength, ok);
+    return ok;
+}
+
+/*!
+ *  @brief Starts a read. Completes immediately on i2c-dev.
+ *
+ *  @return True if the transfer was started, false if the result of
+ *  the previous one has not been polled.
+*/
+bool LinuxI2cTransport::startRead(uint8_t address, uint8_t *data, uint8_t length) {
+    if (transfer != TRANSFER_IDLE) {
+        return false;
+    }
+    transfer = read(address, data, length) ? TRANSFER_DONE : TRANSFER_FAILED;
+    return true;
+}
+
+/*!
+ *  @brief Starts a write-then-read. Completes immediately on i2c-dev.
+ *
+ *  @return True if the transfer was started, false if the result of
+ *  the previous one has not been polled.
+*/
+bool LinuxI2cTransport::startWriteRead(uint8_t address, const uint8_t *out, uint8_t outLength,
+                                       uint8_t *in, uint8_t inLength) {
+    if (transfer != TRANSFER_IDLE) {
+        return false;
+    }
+    transfer = writeRead(address, out, outLength, in, inLength) ? TRANSFER_DONE : TRANSFER_FAILED;
+    return true;
+}
+
+/*!
+ *  @brief Reports the state of the last started transfer. A finished
+ *  transfer is reported once, after which the transport is idle again.
+ *
+ *  @return The transfer state.
+*/
+TransferState LinuxI2cTransport::poll(void) {
+    const TransferState state = transfer;
+    if (state != TRANSFER_BUSY) {
+        transfer = TRANSFER_IDLE;
+    }
+    return state;
+}
+
+#endif // __linux__
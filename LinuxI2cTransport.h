@@ -0,0 +1,60 @@
+#ifndef LinuxI2cTransport_h
+#define LinuxI2cTransport_h
+
+#include <stdint.h>
+
+#include "RegisterPointers.h"
+#include "TransferState.h"
+
+/*!
+ *  @brief Transport for INA260Device using the Linux i2c-dev interface
+ *  (/dev/i2c-N).
+ *
+ *  The transport owns the file descriptor and is not copyable; share
+ *  one instance between all devices on the same bus. Register reads use
+ *  a single I2C_RDWR ioctl (pointer write, repeated start, data read),
+ *  and syscallCount() reports the number of kernel calls issued. i2c-dev
+ *  is blocking, so the asynchronous start calls complete the transfer
+ *  before returning. The transport keeps the register pointer of each
+ *  INA260 on the bus.
+*/
+class LinuxI2cTransport {
+    private:
+        char path[32];
+        int fd;
+        int selected;
+        uint32_t syscalls;
+        TransferState transfer;
+        RegisterPointers registerPointers;
+
+        bool select(uint8_t address);
+
+    public:
+        explicit LinuxI2cTransport(int busNumber);
+        explicit LinuxI2cTransport(const char *devicePath);
+        ~LinuxI2cTransport(void);
+
+        LinuxI2cTransport(const LinuxI2cTransport &) = delete;
+        LinuxI2cTransport &operator=(const LinuxI2cTransport &) = delete;
+
+        bool begin(void);
+        void end(void);
+
+        bool probe(uint8_t address);
+        bool write(uint8_t address, const uint8_t *data, uint8_t length);
+        bool read(uint8_t address, uint8_t *data, uint8_t length);
+        bool writeRead(uint8_t address, const uint8_t *out, uint8_t outLength,
+                       uint8_t *in, uint8_t inLength);
+
+        bool startRead(uint8_t address, uint8_t *data, uint8_t length);
+        bool startWriteRead(uint8_t address, const uint8_t *out, uint8_t outLength,
+                            uint8_t *in, uint8_t inLength);
+        TransferState poll(void);
+
+        uint32_t syscallCount(void) const { return syscalls; }
+        void resetSyscallCount(void) { syscalls = 0; }
+
+        RegisterPointers &pointers(void) { return registerPointers; }
+};
+
+#endif // LinuxI2cTransport.H
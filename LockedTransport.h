@@ -0,0 +1,201 @@
+#ifndef LockedTransport_h
+#define LockedTransport_h
+
+#include <stdint.h>
+
+#include "RegisterPointers.h"
+#include "TransferState.h"
+
+#if defined(__linux__) && !defined(ARDUINO)
+    #include <pthread.h>
+
+/*!
+ *  @brief Recursive pthread mutex for LockedTransport, so a thread can
+ *  hold a Transaction and still make driver calls.
+*/
+class INA260Mutex {
+    private:
+        pthread_mutex_t mutex;
+
+    public:
+        INA260Mutex(void) {
+            pthread_mutexattr_t attributes;
+            pthread_mutexattr_init(&attributes);
+            pthread_mutexattr_settype(&attributes, PTHREAD_MUTEX_RECURSIVE);
+            pthread_mutex_init(&mutex, &attributes);
+            pthread_mutexattr_destroy(&attributes);
+        }
+
+        ~INA260Mutex(void) {
+            pthread_mutex_destroy(&mutex);
+        }
+
+        INA260Mutex(const INA260Mutex &) = delete;
+        INA260Mutex &operator=(const INA260Mutex &) = delete;
+
+        void lock(void) {
+            pthread_mutex_lock(&mutex);
+        }
+
+        void unlock(void) {
+            pthread_mutex_unlock(&mutex);
+        }
+};
+#endif
+
+/*!
+ *  @brief Transport wrapper that makes one bus safe to share between
+ *  threads (or RTOS tasks), each with its own INA260Device.
+ *
+ *  Every bus transaction runs with the lock held. A register read is a
+ *  single writeRead() (pointer write, repeated start, data read), so
+ *  another thread can never move the pointer between the pointer write
+ *  and the read. The lock is held only for the transfer itself, so
+ *  threads polling different devices contend only for bus time.
+ *
+ *  Lock is any class with lock() and unlock(): INA260Mutex on Linux, or
+ *  a wrapper around the RTOS mutex on a microcontroller. It must be
+ *  recursive, for Transaction around driver calls and for asynchronous
+ *  transfers.
+ *
+ *  An asynchronous transfer holds the lock from startRead() or
+ *  startWriteRead() until poll() reports it finished, so other threads
+ *  wait for the bus instead of taking it mid-transfer. poll() must be
+ *  called from the thread that started the transfer, until it returns
+ *  something other than TRANSFER_BUSY.
+ *
+ *  Calls that make several transactions (readSnapshot(), the
+ *  read-modify-write setters) are only atomic as a whole inside a
+ *  Transaction. The pointer cache checks the device's register pointer
+ *  and then reads in two steps, so objects for the same address in
+ *  different threads must disable it, or share one object under a
+ *  Transaction.
+*/
+template <class Transport, class Lock>
+class LockedTransport {
+    private:
+        Transport *bus;
+        Lock *mutex;
+        bool pending;          // An asynchronous transfer holds the lock
+
+    public:
+        /*!
+         *  @brief Holds the bus for a sequence of driver calls, e.g. a
+         *  read-modify-write of the configuration.
+        */
+        class Transaction {
+            private:
+                Lock *mutex;
+
+            public:
+                explicit Transaction(LockedTransport &bus) : mutex(bus.mutex) {
+                    mutex->lock();
+                }
+
+                ~Transaction(void) {
+                    mutex->unlock();
+                }
+
+                Transaction(const Transaction &) = delete;
+                Transaction &operator=(const Transaction &) = delete;
+        };
+
+        /*!
+         *  @brief Wraps a transport.
+         *
+         *  @param bus The transport every device on the bus goes through.
+         *  @param mutex The lock guarding it.
+        */
+        LockedTransport(Transport &bus, Lock &mutex) :
+            bus(&bus),
+            mutex(&mutex),
+            pending(false) {}
+
+        bool begin(void) {
+            Transaction transaction(*this);
+            return bus->begin();
+        }
+
+        bool probe(uint8_t address) {
+            Transaction transaction(*this);
+            return bus->probe(address);
+        }
+
+        bool write(uint8_t address, const uint8_t *data, uint8_t length) {
+            Transaction transaction(*this);
+            return bus->write(address, data, length);
+        }
+
+        bool read(uint8_t address, uint8_t *data, uint8_t length) {
+            Transaction transaction(*this);
+            return bus->read(address, data, length);
+        }
+
+        bool writeRead(uint8_t address, const uint8_t *out, uint8_t outLength,
+                       uint8_t *in, uint8_t inLength) {
+            Transaction transaction(*this);
+            return bus->writeRead(address, out, outLength, in, inLength);
+        }
+
+        /*!
+         *  @brief Takes the lock and starts an asynchronous read on the
+         *  wrapped transport. The lock stays held until poll() reports
+         *  the transfer finished.
+         *
+         *  @return True if started, otherwise false with the lock released.
+        */
+        bool startRead(uint8_t address, uint8_t *data, uint8_t length) {
+            mutex->lock();
+            if (! bus->startRead(address, data, length)) {
+                mutex->unlock();
+                return false;
+            }
+            pending = true;
+            return true;
+        }
+
+        /*!
+         *  @brief Takes the lock and starts an asynchronous write-then-read
+         *  on the wrapped transport, as startRead().
+        */
+        bool startWriteRead(uint8_t address, const uint8_t *out, uint8_t outLength,
+                            uint8_t *in, uint8_t inLength) {
+            mutex->lock();
+            if (! bus->startWriteRead(address, out, outLength, in, inLength)) {
+                mutex->unlock();
+                return false;
+            }
+            pending = true;
+            return true;
+        }
+
+        /*!
+         *  @brief Polls the wrapped transport, releasing the lock taken by
+         *  the start call once the transfer has finished. Starting thread
+         *  only.
+         *
+         *  @return The transfer state, TRANSFER_IDLE if none was started.
+        */
+        TransferState poll(void) {
+            Transaction transaction(*this);
+            if (! pending) {
+                return TRANSFER_IDLE;
+            }
+            const TransferState state = bus->poll();
+            if (state != TRANSFER_BUSY) {
+                pending = false;
+                mutex->unlock();
+            }
+            return state;
+        }
+
+        /*!
+         *  @brief The wrapped transport's register pointers, which it
+         *  updates under the lock.
+        */
+        RegisterPointers &pointers(void) {
+            return bus->pointers();
+        }
+};
+
+#endif // LockedTransport.H
@@ -0,0 +1,227 @@
+#ifndef MockTransport_h
+#define MockTransport_h
+
+#include <stdint.h>
+#include <string.h>
+
+#include "RegisterPointers.h"
+#include "TransferState.h"
+
+/*!
+ *  @brief In-memory transport for INA260Device.
+ *
+ *  Emulates up to MaxDevices register files with the INA260 pointer
+ *  semantics (a 1-byte write sets the pointer, a 3-byte write sets the
+ *  pointer and the register, a read returns the pointed-to register)
+ *  and counts every transaction so the driver's bus traffic can be
+ *  inspected off-target. Asynchronous transfers complete after
+ *  asyncDelay calls to poll().
+*/
+template <uint8_t MaxDevices = 1>
+class MockTransport {
+    public:
+        struct Device {
+            uint8_t address;
+            uint8_t pointer;
+            uint16_t registers[256];
+        };
+
+        uint32_t probes;
+        uint32_t writes;
+        uint32_t reads;
+        uint32_t writeReads;
+        uint32_t bytesWritten;
+        uint32_t bytesRead;
+        uint32_t failNext;
+        uint32_t asyncDelay;
+
+        MockTransport(void) : asyncDelay(0), deviceCount(0), pending(), registerPointers() {
+            resetCounters();
+        }
+
+        /*!
+         *  @brief Adds an emulated device with all registers cleared.
+         *
+         *  @param address The 7-bit device address.
+         *  @return The device, or nullptr if there is no free slot.
+        */
+        Device *addDevice(uint8_t address) {
+            if (deviceCount >= MaxDevices) {
+                return nullptr;
+            }
+            Device *dev = &deviceList[deviceCount++];
+            memset(dev, 0, sizeof(Device));
+            dev->address = address;
+            return dev;
+        }
+
+        /*!
+         *  @brief Finds an emulated device.
+         *
+         *  @param address The 7-bit device address.
+         *  @return The device, or nullptr if none answers on address.
+        */
+        Device *device(uint8_t address) {
+            for (uint8_t i = 0; i < deviceCount; i++) {
+                if (deviceList[i].address == address) {
+                    return &deviceList[i];
+                }
+            }
+            return nullptr;
+        }
+
+        /*!
+         *  @brief Clears the transaction counters and pending failures.
+        */
+        void resetCounters(void) {
+            probes = 0;
+            writes = 0;
+            reads = 0;
+            writeReads = 0;
+            bytesWritten = 0;
+            bytesRead = 0;
+            failNext = 0;
+        }
+
+        bool begin(void) {
+            return true;
+        }
+
+        bool probe(uint8_t address) {
+            probes++;
+            return (! fail() && device(address) != nullptr);
+        }
+
+        bool write(uint8_t address, const uint8_t *data, uint8_t length) {
+            writes++;
+            Device *dev = device(address);
+            const bool ok = (! fail() && dev != nullptr && length > 0);
+            registerPointers.wrote(address, data, length, ok);
+            if (! ok) {
+                return false;
+            }
+            bytesWritten += length;
+            dev->pointer = data[0];
+            if (length >= 3) {
+                dev->registers[dev->pointer] = (static_cast<uint16_t>(data[1]) << 8) | data[2];
+            }
+            return true;
+        }
+
+        bool read(uint8_t address, uint8_t *data, uint8_t length) {
+            reads++;
+            Device *dev = device(address);
+            const bool ok = (! fail() && dev != nullptr);
+            registerPointers.read(address, ok);
+            if (! ok) {
+                return false;
+            }
+            bytesRead += length;
+            const uint16_t value = dev->registers[dev->pointer];
+            for (uint8_t i = 0; i < length; i++) {
+                data[i] = (i & 1) ? (value & 0xFF) : (value >> 8);
+            }
+            return true;
+        }
+
+        /*!
+         *  @brief Write then read with a repeated start. Counted once in
+         *  writeReads rather than in writes and reads.
+        */
+        bool writeRead(uint8_t address, const uint8_t *out, uint8_t outLength,
+                       uint8_t *in, uint8_t inLength) {
+            writeReads++;
+            const uint32_t w = writes;
+            const uint32_t r = reads;
+            const bool ok = write(address, out, outLength) && read(address, in, inLength);
+            writes = w;
+            reads = r;
+            return ok;
+        }
+
+        /*!
+         *  @brief Starts an asynchronous read, completed by poll().
+         *
+         *  @return True if started, false if a transfer is in progress.
+        */
+        bool startRead(uint8_t address, uint8_t *data, uint8_t length) {
+            return startWriteRead(address, nullptr, 0, data, length);
+        }
+
+        /*!
+         *  @brief Starts an asynchronous write-then-read, completed by
+         *  poll(). A zero outLength performs a plain read.
+         *
+         *  @return True if started, false if a transfer is in progress.
+        */
+        bool startWriteRead(uint8_t address, const uint8_t *out, uint8_t outLength,
+                            uint8_t *in, uint8_t inLength) {
+            if (pending.state == TRANSFER_BUSY) {
+                return false;
+            }
+            pending.state = TRANSFER_BUSY;
+            pending.address = address;
+            pending.out = out;
+            pending.outLength = outLength;
+            pending.in = in;
+            pending.inLength = inLength;
+            pending.remaining = asyncDelay;
+            return true;
+        }
+
+        /*!
+         *  @brief Advances the pending asynchronous transfer by one step.
+         *  A finished transfer is reported once, after which the
+         *  transport is idle again.
+         *
+         *  @return The transfer state.
+        */
+        TransferState poll(void) {
+            if (pending.state == TRANSFER_BUSY) {
+                if (pending.remaining > 0) {
+                    pending.remaining--;
+                    return TRANSFER_BUSY;
+                }
+                bool ok;
+                if (pending.outLength > 0) {
+                    ok = writeRead(pending.address, pending.out, pending.outLength, pending.in, pending.inLength);
+                } else {
+                    ok = read(pending.address, pending.in, pending.inLength);
+                }
+                pending.state = ok ? TRANSFER_DONE : TRANSFER_FAILED;
+            }
+            const TransferState state = pending.state;
+            pending.state = TRANSFER_IDLE;
+            return state;
+        }
+
+        RegisterPointers &pointers(void) {
+            return registerPointers;
+        }
+
+    private:
+        struct Transfer {
+            TransferState state;
+            uint8_t address;
+            const uint8_t *out;
+            uint8_t outLength;
+            uint8_t *in;
+            uint8_t inLength;
+            uint32_t remaining;
+        };
+
+        Device deviceList[MaxDevices];
+        uint8_t deviceCount;
+        Transfer pending;
+        RegisterPointers registerPointers;
+
+        bool fail(void) {
+            if (failNext == 0) {
+                return false;
+            }
+            failNext--;
+            return true;
+        }
+};
+
+#endif // MockTransport.H
@@ -0,0 +1,78 @@
+#ifndef RegisterPointers_h
+#define RegisterPointers_h
+
+#include <stdint.h>
+
+#define INA260_POINTER_FIRST            0x40 // Lowest address tracked
+#define INA260_POINTER_COUNT            16   // Addresses 0x40 to 0x4F
+
+/*!
+ *  @brief The register pointer last sent to each INA260 address on one
+ *  bus.
+ *
+ *  The pointer belongs to the chip, not to a driver object, so the
+ *  transport keeps it: write(), read() and writeRead() update the entry
+ *  for their address whoever calls them, and every INA260Device, scan
+ *  and asynchronous reader on the bus sees the same value. A failed
+ *  transfer leaves the pointer unknown.
+*/
+class RegisterPointers {
+    private:
+        int16_t pointers[INA260_POINTER_COUNT]; // -1 if unknown
+
+        static bool tracked(uint8_t address) {
+            return static_cast<uint8_t>(address - INA260_POINTER_FIRST) < INA260_POINTER_COUNT;
+        }
+
+    public:
+        RegisterPointers(void) {
+            clear();
+        }
+
+        /*!
+         *  @brief Forgets every pointer, e.g. after a bus reset.
+        */
+        void clear(void) {
+            for (uint8_t i = 0; i < INA260_POINTER_COUNT; i++) {
+                pointers[i] = -1;
+            }
+        }
+
+        /*!
+         *  @brief Gets the register the device points at.
+         *
+         *  @return The register, or -1 if unknown.
+        */
+        int16_t get(uint8_t address) const {
+            return tracked(address) ? pointers[address - INA260_POINTER_FIRST] : -1;
+        }
+
+        /*!
+         *  @brief Forgets the pointer of one device.
+        */
+        void invalidate(uint8_t address) {
+            if (tracked(address)) {
+                pointers[address - INA260_POINTER_FIRST] = -1;
+            }
+        }
+
+        /*!
+         *  @brief Records a write; its first byte is the new pointer.
+        */
+        void wrote(uint8_t address, const uint8_t *data, uint8_t length, bool ok) {
+            if (tracked(address)) {
+                pointers[address - INA260_POINTER_FIRST] = (ok && length > 0) ? data[0] : -1;
+            }
+        }
+
+        /*!
+         *  @brief Records a read, which leaves the pointer where it was.
+        */
+        void read(uint8_t address, bool ok) {
+            if (! ok) {
+                invalidate(address);
+            }
+        }
+};
+
+#endif // RegisterPointers.H
@@ -0,0 +1,95 @@
+#ifndef SimulatedAlertPin_h
+#define SimulatedAlertPin_h
+
+#include <stdint.h>
+
+#include "INA260Alert.h"
+#include "INA260Model.h"
+#include "SimulatedTransport.h"
+
+/*!
+ *  @brief ALERT pin source watching an INA260Model, for host tests.
+ *
+ *  Edges are taken from the model's count of ALERT assertions rather
+ *  than its level, so an edge is reported even when ALERT was released
+ *  and asserted again while nobody looked (e.g. the test advanced the
+ *  bus between polls). service() brings the model up to the bus clock,
+ *  then advances the clock in steps of resolution microseconds until a
+ *  new edge or the timeout, and reports the latest edge with the
+ *  virtual time it happened, so interrupt-to-sample latency can be
+ *  measured in virtual time. Several edges between two services are
+ *  reported once, as the last of them.
+*/
+template <uint8_t MaxDevices = 16>
+class SimulatedAlertPin {
+    private:
+        SimulatedTransport<MaxDevices> *bus;
+        INA260Model *model;
+        uint32_t resolution;
+        uint32_t edges;          // Model's edge count when last reported
+        AlertHandler handler;
+        void *context;
+
+        /*!
+         *  @brief Reports an edge if the model asserted ALERT since the
+         *  last call.
+         *
+         *  @return True if an edge was reported.
+        */
+        bool sample(void) {
+            const uint32_t count = model->getAlertEdgeCount();
+            if (count == edges) {
+                return false;
+            }
+            edges = count;
+            if (handler != nullptr) {
+                handler(context, static_cast<uint32_t>(model->getLastAlertEdgeMicros()));
+            }
+            return true;
+        }
+
+    public:
+        /*!
+         *  @brief Instantiates a pin watching one model.
+         *
+         *  @param bus The simulated bus owning the virtual clock.
+         *  @param model The device whose ALERT output is watched.
+         *  @param resolution Clock step while waiting, in microseconds.
+        */
+        SimulatedAlertPin(SimulatedTransport<MaxDevices> &bus, INA260Model &model, uint32_t resolution = 10) :
+            bus(&bus),
+            model(&model),
+            resolution(resolution ? resolution : 1),
+            edges(0),
+            handler(nullptr),
+            context(nullptr) {}
+
+        bool begin(AlertHandler handler, void *context) {
+            this->handler = handler;
+            this->context = context;
+            bus->advance(0);
+            edges = model->getAlertEdgeCount();
+            return true;
+        }
+
+        void end(void) {
+            handler = nullptr;
+        }
+
+        /*!
+         *  @brief Runs virtual time until ALERT asserts or the timeout
+         *  expires, delivering the edge to the handler.
+         *
+         *  @param timeoutMicros Longest virtual time to wait, 0 to only check.
+        */
+        void service(uint32_t timeoutMicros) {
+            bus->advance(0);
+            uint32_t waited = 0;
+            while (! sample() && waited < timeoutMicros) {
+                bus->advance(resolution);
+                waited += resolution;
+            }
+        }
+};
+
+#endif // SimulatedAlertPin.H
@@ -0,0 +1,240 @@
+#ifndef SimulatedTransport_h
+#define SimulatedTransport_h
+
+#include <stdint.h>
+
+#include "INA260Clock.h"
+#include "INA260Model.h"
+#include "RegisterPointers.h"
+#include "TransferState.h"
+
+/*!
+ *  @brief Transport connecting INA260Device to INA260Model instances.
+ *
+ *  The transport owns the virtual clock: every transaction first brings
+ *  the models up to date and then, if a bus clock is set, advances the
+ *  clock by the time the transaction would take on the wire (9 bits per
+ *  byte plus start and stop), so driver calls can be timed on a host.
+ *  In real-time mode each transaction also blocks for that long, like
+ *  a blocking i2c-dev ioctl, so threads sharing a CPU can be measured.
+ *  Asynchronous transfers complete after asyncDelay calls to poll().
+*/
+template <uint8_t MaxDevices = 16>
+class SimulatedTransport {
+    public:
+        uint32_t transactions;
+        uint32_t asyncDelay;
+
+        SimulatedTransport(void) :
+            transactions(0),
+            asyncDelay(0),
+            models(),
+            modelCount(0),
+            clock(0),
+            busHz(0),
+            realTime(false),
+            pending(),
+            registerPointers() {}
+
+        /*!
+         *  @brief Connects a device model to the bus.
+         *
+         *  @param model The model; it must outlive the transport.
+         *  @return True if added, false if the bus is full.
+        */
+        bool attach(INA260Model &model) {
+            if (modelCount >= MaxDevices) {
+                return false;
+            }
+            models[modelCount++] = &model;
+            return true;
+        }
+
+        /*!
+         *  @brief Sets the bus clock used to charge transaction time to
+         *  the virtual clock.
+         *
+         *  @param hz Bus clock in Hz, 0 to make transactions take no time.
+        */
+        void setBusClock(uint32_t hz) {
+            busHz = hz;
+        }
+
+        /*!
+         *  @brief Makes each transaction block the calling thread for
+         *  the time charged to the virtual clock. Needs a bus clock.
+         *
+         *  @param enabled True to block, false to return at once.
+        */
+        void setRealTime(bool enabled) {
+            realTime = enabled;
+        }
+
+        /*!
+         *  @brief Gets the virtual time.
+         *
+         *  @return Microseconds since the transport was created.
+        */
+        uint64_t now(void) const {
+            return clock;
+        }
+
+        /*!
+         *  @brief Advances the virtual time and runs the models up to it.
+         *
+         *  @param micros Microseconds to advance.
+        */
+        void advance(uint64_t micros) {
+            clock += micros;
+            sync();
+        }
+
+        bool begin(void) {
+            return true;
+        }
+
+        bool probe(uint8_t address) {
+            return transaction(address, 0) != nullptr;
+        }
+
+        bool write(uint8_t address, const uint8_t *data, uint8_t length) {
+            INA260Model *model = transaction(address, length);
+            registerPointers.wrote(address, data, length, model != nullptr);
+            if (model == nullptr || length == 0) {
+                return false;
+            }
+            model->setPointer(data[0]);
+            if (length >= 3) {
+                model->writeRegister(data[0], (static_cast<uint16_t>(data[1]) << 8) | data[2]);
+            }
+            return true;
+        }
+
+        bool read(uint8_t address, uint8_t *data, uint8_t length) {
+            INA260Model *model = transaction(address, length);
+            registerPointers.read(address, model != nullptr);
+            if (model == nullptr) {
+                return false;
+            }
+            const uint16_t value = model->readRegister(model->getPointer());
+            for (uint8_t i = 0; i < length; i++) {
+                data[i] = (i & 1) ? (value & 0xFF) : (value >> 8);
+            }
+            return true;
+        }
+
+        bool writeRead(uint8_t address, const uint8_t *out, uint8_t outLength,
+                       uint8_t *in, uint8_t inLength) {
+            // The repeated start saves a stop and a start; charge the
+            // combined transfer as one transaction with one repeated start
+            // and the address sent again.
+            INA260Model *model = transaction(address, outLength + 1 + inLength, 1);
+            registerPointers.wrote(address, out, outLength, model != nullptr);
+            if (model == nullptr || outLength == 0) {
+                return false;
+            }
+            model->setPointer(out[0]);
+            const uint16_t value = model->readRegister(out[0]);
+            for (uint8_t i = 0; i < inLength; i++) {
+                in[i] = (i & 1) ? (value & 0xFF) : (value >> 8);
+            }
+            return true;
+        }
+
+        bool startRead(uint8_t address, uint8_t *data, uint8_t length) {
+            return startWriteRead(address, nullptr, 0, data, length);
+        }
+
+        bool startWriteRead(uint8_t address, const uint8_t *out, uint8_t outLength,
+                            uint8_t *in, uint8_t inLength) {
+            if (pending.state == TRANSFER_BUSY) {
+                return false;
+            }
+            pending.state = TRANSFER_BUSY;
+            pending.address = address;
+            pending.out = out;
+            pending.outLength = outLength;
+            pending.in = in;
+            pending.inLength = inLength;
+            pending.remaining = asyncDelay;
+            return true;
+        }
+
+        TransferState poll(void) {
+            if (pending.state == TRANSFER_BUSY) {
+                if (pending.remaining > 0) {
+                    pending.remaining--;
+                    return TRANSFER_BUSY;
+                }
+                bool ok;
+                if (pending.outLength > 0) {
+                    ok = writeRead(pending.address, pending.out, pending.outLength, pending.in, pending.inLength);
+                } else {
+                    ok = read(pending.address, pending.in, pending.inLength);
+                }
+                pending.state = ok ? TRANSFER_DONE : TRANSFER_FAILED;
+            }
+            const TransferState state = pending.state;
+            pending.state = TRANSFER_IDLE;
+            return state;
+        }
+
+        RegisterPointers &pointers(void) {
+            return registerPointers;
+        }
+
+    private:
+        struct Transfer {
+            TransferState state;
+            uint8_t address;
+            const uint8_t *out;
+            uint8_t outLength;
+            uint8_t *in;
+            uint8_t inLength;
+            uint32_t remaining;
+        };
+
+        INA260Model *models[MaxDevices];
+        uint8_t modelCount;
+        uint64_t clock;
+        uint32_t busHz;
+        bool realTime;
+        Transfer pending;
+        RegisterPointers registerPointers;
+
+        void sync(void) {
+            for (uint8_t i = 0; i < modelCount; i++) {
+                models[i]->update(clock);
+            }
+        }
+
+        /*!
+         *  @brief Accounts for one bus transaction of the given payload and
+         *  finds the model that acknowledges the address.
+         *
+         *  @param repeatedStarts Repeated STARTs inside the transaction.
+         *  @return The model, or nullptr if nothing answers.
+        */
+        INA260Model *transaction(uint8_t address, uint8_t payload, uint8_t repeatedStarts = 0) {
+            transactions++;
+            sync();
+            if (busHz != 0) {
+                // Start + address byte + payload bytes + stop, 9 clocks per
+                // byte, as INA260BusTiming counts them.
+                const uint32_t bits = 2 + repeatedStarts + 9 * (1 + payload);
+                const uint32_t micros = (bits * 1000000ULL + busHz - 1) / busHz;
+                clock += micros;
+                if (realTime) {
+                    ina260SleepMicros(micros);
+                }
+            }
+            for (uint8_t i = 0; i < modelCount; i++) {
+                if (models[i]->getAddress() == address) {
+                    return models[i];
+                }
+            }
+            return nullptr;
+        }
+};
+
+#endif // SimulatedTransport.H
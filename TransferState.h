@@ -0,0 +1,11 @@
+#ifndef TransferState_h
+#define TransferState_h
+
+typedef enum _transferState {
+    TRANSFER_IDLE   = 0, // No transfer started
+    TRANSFER_BUSY   = 1, // Transfer in progress
+    TRANSFER_DONE   = 2, // Transfer completed
+    TRANSFER_FAILED = 3, // Transfer was not acknowledged or returned too few bytes
+} TransferState;
+
+#endif // TransferState.H
@@ -0,0 +1,183 @@
+#ifndef WireTransport_h
+#define WireTransport_h
+
+#ifndef Arduino
+    #include "Arduino.h"
+#endif
+#ifndef Wire
+    #include <Wire.h>
+#endif
+
+#include "RegisterPointers.h"
+#include "TransferState.h"
+
+/*!
+ *  @brief Transport for INA260Device using an Arduino TwoWire bus.
+ *
+ *  All methods are defined inline so the driver's register accessors
+ *  compile down to direct Wire calls. Wire is blocking, so the
+ *  asynchronous startWriteRead()/startRead() complete the transfer
+ *  before returning and poll() reports the outcome. The transport keeps
+ *  the register pointer of each INA260 on the bus.
+*/
+class WireTransport {
+    private:
+        TwoWire *wire;
+        bool initialized;
+        TransferState transfer;
+        RegisterPointers registerPointers;
+
+    public:
+        explicit WireTransport(TwoWire &wire) : wire(&wire), initialized(false), transfer(TRANSFER_IDLE), registerPointers() {}
+
+        static WireTransport &defaultInstance(void);
+
+        bool begin(void);
+        bool probe(uint8_t address);
+        bool write(uint8_t address, const uint8_t *data, uint8_t length);
+        bool read(uint8_t address, uint8_t *data, uint8_t length);
+        bool writeRead(uint8_t address, const uint8_t *out, uint8_t outLength,
+                       uint8_t *in, uint8_t inLength);
+
+        bool startRead(uint8_t address, uint8_t *data, uint8_t length);
+        bool startWriteRead(uint8_t address, const uint8_t *out, uint8_t outLength,
+                            uint8_t *in, uint8_t inLength);
+        TransferState poll(void);
+
+        RegisterPointers &pointers(void) { return registerPointers; }
+};
+
+/*!
+ *  @brief The transport for the global Wire object, shared by every
+ *  INA260 constructed without an explicit bus.
+*/
+inline WireTransport &WireTransport::defaultInstance(void) {
+    static WireTransport transport(Wire);
+    return transport;
+}
+
+/*!
+ *  @brief Initializes the Wire bus. Safe to call more than once.
+ *
+ *  @return True if the bus is ready.
+*/
+inline bool WireTransport::begin(void) {
+    if (! initialized) {
+        wire->begin();
+        initialized = true;
+    }
+    return initialized;
+}
+
+/*!
+ *  @brief Checks whether a device acknowledges the address.
+ *
+ *  @param address The 7-bit device address.
+ *  @return True if the device acknowledged, otherwise false.
+*/
+inline bool WireTransport::probe(uint8_t address) {
+    wire->beginTransmission(address);
+    return (wire->endTransmission() == 0);
+}
+
+/*!
+ *  @brief Writes bytes to the device in a single transaction.
+ *
+ *  @param address The 7-bit device address.
+ *  @param data The bytes to write.
+ *  @param length The number of bytes to write.
+ *  @return True if write was successfull, otherwise false.
+*/
+inline bool WireTransport::write(uint8_t address, const uint8_t *data, uint8_t length) {
+    wire->beginTransmission(address);
+    wire->write(data, length);
+    const bool ok = (wire->endTransmission() == 0);
+    registerPointers.wrote(address, data, length, ok);
+    return ok;
+}
+
+/*!
+ *  @brief Reads bytes from the device in a single transaction.
+ *
+ *  @param address The 7-bit device address.
+ *  @param data Buffer receiving the bytes.
+ *  @param length The number of bytes to read.
+ *  @return True if all bytes were received, otherwise false.
+*/
+inline bool WireTransport::read(uint8_t address, uint8_t *data, uint8_t length) {
+    wire->requestFrom(address, length);
+    if (wire->available() != length) {
+        registerPointers.read(address, false);
+        return false;
+    }
+    for (uint8_t i = 0; i < length; i++) {
+        data[i] = wire->read();
+    }
+    return true;
+}
+
+/*!
+ *  @brief Writes bytes then reads bytes using a repeated start, so the
+ *  register pointer write and the data read form one bus transaction.
+ *
+ *  @param address The 7-bit device address.
+ *  @param out The bytes to write.
+ *  @param outLength The number of bytes to write.
+ *  @param in Buffer receiving the bytes.
+ *  @param inLength The number of bytes to read.
+ *  @return True if the write was acknowledged and all bytes were
+ *  received, otherwise false.
+*/
+inline bool WireTransport::writeRead(uint8_t address, const uint8_t *out, uint8_t outLength,
+                                     uint8_t *in, uint8_t inLength) {
+    wire->beginTransmission(address);
+    wire->write(out, outLength);
+    const bool ok = (wire->endTransmission(false) == 0);
+    registerPointers.wrote(address, out, outLength, ok);
+    return ok && read(address, in, inLength);
+}
+
+/*!
+ *  @brief Starts a read. Completes immediately on Wire.
+ *
+ *  @return True if the transfer was started, false if the result of
+ *  the previous one has not been polled.
+*/
+inline bool WireTransport::startRead(uint8_t address, uint8_t *data, uint8_t length) {
+    if (transfer != TRANSFER_IDLE) {
+        return false;
+    }
+    transfer = read(address, data, length) ? TRANSFER_DONE : TRANSFER_FAILED;
+    return true;
+}
+
+/*!
+ *  @brief Starts a write-then-read. Completes immediately on Wire.
+ *
+ *  @return True if the transfer was started, false if the result of
+ *  the previous one has not been polled.
+*/
+inline bool WireTransport::startWriteRead(uint8_t address, const uint8_t *out, uint8_t outLength,
+                                          uint8_t *in, uint8_t inLength) {
+    if (transfer != TRANSFER_IDLE) {
+        return false;
+    }
+    transfer = writeRead(address, out, outLength, in, inLength) ? TRANSFER_DONE : TRANSFER_FAILED;
+    return true;
+}
+
+/*!
+ *  @brief Reports the state of the last started transfer. A finished
+ *  transfer is reported once, after which the transport is idle again.
+ *
+ *  @return The transfer state.
+*/
+inline TransferState WireTransport::poll(void) {
+    const TransferState state = transfer;
+    if (state != TRANSFER_BUSY) {
+        transfer = TRANSFER_IDLE;
+    }
+    return state;
+}
+
+#endif // WireTransport.H
@@ -0,0 +1,38 @@
+#ifndef Bench_h
+#define Bench_h
+
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+/*!
+ *  @brief Helpers shared by the benchmarks.
+*/
+
+static inline uint64_t benchNanos(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + now.tv_nsec;
+}
+
+// True when ctest asked for a short smoke run.
+static inline bool benchQuick(int argc, char **argv) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--quick") == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// The first argument that is not an option, or fallback.
+static inline const char *benchArgument(int argc, char **argv, const char *fallback) {
+    for (int i = 1; i < argc; i++) {
+        if (argv[i][0] != '-') {
+            return argv[i];
+        }
+    }
+    return fallback;
+}
+
+#endif // Bench.H
@@ -0,0 +1,71 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "INA260.h"
+
+#include "Bench.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+    static inline uint64_t cycles(void) { return __rdtsc(); }
+    #define BENCH_UNIT "cycles"
+#else
+    static inline uint64_t cycles(void) { return benchNanos(); }
+    #define BENCH_UNIT "ns"
+#endif
+
+/*!
+ *  @brief Cost per register conversion of the float readings against
+ *  the integer ones, on the host (TSC cycles on x86, nanoseconds
+ *  elsewhere). Targets without an FPU show a much larger gap; this keeps
+ *  the integer helpers honest where the build runs.
+*/
+
+#define BENCH_SAMPLES 4096
+
+static uint16_t raw[BENCH_SAMPLES];
+static volatile double sink;
+
+template <typename Convert>
+static double measure(Convert convert, uint32_t rounds) {
+    typename Convert::Sum sum = 0;
+    const uint64_t start = cycles();
+    for (uint32_t round = 0; round < rounds; round++) {
+        for (uint32_t i = 0; i < BENCH_SAMPLES; i++) {
+            sum += convert(raw[i]);
+        }
+    }
+    const uint64_t elapsed = cycles() - start;
+    sink = sum;
+    return static_cast<double>(elapsed) / (static_cast<double>(rounds) * BENCH_SAMPLES);
+}
+
+// Each path sums in its own type, so neither pays for a conversion.
+struct FloatCurrent { typedef float Sum; float operator()(uint16_t value) const { return static_cast<int16_t>(value) * 1.25f; } };
+struct FloatVoltage { typedef float Sum; float operator()(uint16_t value) const { return value * 1.25f; } };
+struct FloatPower { typedef float Sum; float operator()(uint16_t value) const { return value * 10.0f; } };
+struct IntegerCurrent { typedef int64_t Sum; int32_t operator()(uint16_t value) const { return currentMicroAmps(value); } };
+struct IntegerVoltage { typedef int64_t Sum; uint32_t operator()(uint16_t value) const { return busVoltageMicroVolts(value); } };
+struct IntegerPower { typedef int64_t Sum; uint32_t operator()(uint16_t value) const { return powerMicroWatts(value); } };
+
+int main(int argc, char **argv) {
+    const uint32_t rounds = benchQuick(argc, argv) ? 10 : 10000;
+    srand(260);
+    for (uint32_t i = 0; i < BENCH_SAMPLES; i++) {
+        raw[i] = static_cast<uint16_t>(rand());
+    }
+
+    printf("%-8s %10s %10s   (" BENCH_UNIT " per conversion)\n", "", "float", "integer");
+    printf("%-8s %10.2f %10.2f\n", "current", measure(FloatCurrent(), rounds), measure(IntegerCurrent(), rounds));
+    printf("%-8s %10.2f %10.2f\n", "voltage", measure(FloatVoltage(), rounds), measure(IntegerVoltage(), rounds));
+    printf("%-8s %10.2f %10.2f\n", "power", measure(FloatPower(), rounds), measure(IntegerPower(), rounds));
+
+    // The two paths must agree.
+    for (uint32_t i = 0; i < BENCH_SAMPLES; i++) {
+        if (static_cast<int32_t>(FloatCurrent()(raw[i]) * 1000.0) != currentMicroAmps(raw[i])) {
+            printf("current mismatch at raw 0x%04X\n", raw[i]);
+            return 1;
+        }
+    }
+    return 0;
+}
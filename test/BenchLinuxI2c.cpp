@@ -0,0 +1,67 @@
+#include <stdio.h>
+
+#include "INA260.h"
+#include "LinuxI2cTransport.h"
+
+#include "Bench.h"
+#include "I2cStub.h"
+
+/*!
+ *  @brief System calls and wall time per readCurrent() on
+ *  LinuxI2cTransport.
+ *
+ *  Runs against the i2c-dev stub by default; pass a real adapter, e.g.
+ *  /dev/i2c-1 with an INA260 at 0x40, to measure the hardware. The
+ *  baseline is the separate pointer write and read the driver made
+ *  before register reads became one I2C_RDWR ioctl.
+*/
+
+static volatile float sink;
+
+static void report(const char *name, LinuxI2cTransport &bus, uint32_t count, uint64_t nanos) {
+    printf("%-26s %5.2f syscalls  %8.0f ns  per readCurrent()\n", name,
+           static_cast<double>(bus.syscallCount()) / count, static_cast<double>(nanos) / count);
+}
+
+int main(int argc, char **argv) {
+    const char *path = benchArgument(argc, argv, I2C_STUB_PATH);
+    const uint32_t count = benchQuick(argc, argv) ? 1000 : 100000;
+
+    LinuxI2cTransport bus(path);
+    INA260Device<LinuxI2cTransport> ina(bus, INA260_I2CADDR_DEFAULT);
+    if (! bus.begin() || ! ina.tryReadCurrent().ok()) {
+        printf("no INA260 at 0x40 on %s\n", path);
+        return 1;
+    }
+    printf("%s, %u reads\n", path, count);
+
+    // Baseline: pointer write, stop, then a read.
+    const uint8_t reg = INA260_CURRENT_REGISTER;
+    uint8_t data[2];
+    bus.resetSyscallCount();
+    uint64_t start = benchNanos();
+    for (uint32_t i = 0; i < count; i++) {
+        bus.write(INA260_I2CADDR_DEFAULT, &reg, 1);
+        bus.read(INA260_I2CADDR_DEFAULT, data, 2);
+        sink = data[0];
+    }
+    report("write() + read()", bus, count, benchNanos() - start);
+
+    ina.setPointerCache(false);
+    bus.resetSyscallCount();
+    start = benchNanos();
+    for (uint32_t i = 0; i < count; i++) {
+        sink = ina.readCurrent();
+    }
+    report("I2C_RDWR", bus, count, benchNanos() - start);
+
+    ina.setPointerCache(true);
+    bus.resetSyscallCount();
+    start = benchNanos();
+    for (uint32_t i = 0; i < count; i++) {
+        sink = ina.readCurrent();
+    }
+    report("I2C_RDWR, pointer cached", bus, count, benchNanos() - start);
+
+    return (sink == 1000.0f) ? 0 : 1;
+}
@@ -0,0 +1,93 @@
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+
+#include "INA260SampleRing.h"
+
+#include "Bench.h"
+
+/*!
+ *  @brief Producer-to-consumer throughput of INA260SampleRing, against
+ *  the same ring guarded by a pthread mutex.
+*/
+
+#define BENCH_CAPACITY 1024
+
+// The baseline: one lock around both ends.
+class MutexRing {
+    private:
+        pthread_mutex_t mutex;
+        RawSample samples[BENCH_CAPACITY];
+        uint32_t head;
+        uint32_t tail;
+
+    public:
+        MutexRing(void) : head(0), tail(0) {
+            pthread_mutex_init(&mutex, nullptr);
+        }
+
+        bool push(const RawSample &sample) {
+            pthread_mutex_lock(&mutex);
+            const bool ok = (head - tail != BENCH_CAPACITY);
+            if (ok) {
+                samples[head++ & (BENCH_CAPACITY - 1)] = sample;
+            }
+            pthread_mutex_unlock(&mutex);
+            return ok;
+        }
+
+        bool pop(RawSample &sample) {
+            pthread_mutex_lock(&mutex);
+            const bool ok = (head != tail);
+            if (ok) {
+                sample = samples[tail++ & (BENCH_CAPACITY - 1)];
+            }
+            pthread_mutex_unlock(&mutex);
+            return ok;
+        }
+};
+
+static uint32_t count;
+
+template <class Ring>
+static void *produce(void *context) {
+    Ring *ring = static_cast<Ring *>(context);
+    RawSample sample = {};
+    for (uint32_t i = 0; i < count; i++) {
+        sample.micros = i;
+        while (! ring->push(sample)) {
+            sched_yield();
+        }
+    }
+    return nullptr;
+}
+
+template <class Ring>
+static double run(Ring &ring) {
+    pthread_t producer;
+    const uint64_t start = benchNanos();
+    pthread_create(&producer, nullptr, produce<Ring>, &ring);
+    uint32_t received = 0;
+    RawSample sample;
+    while (received < count) {
+        if (ring.pop(sample)) {
+            received++;
+        } else {
+            sched_yield();
+        }
+    }
+    pthread_join(producer, nullptr);
+    return static_cast<double>(benchNanos() - start) / count;
+}
+
+int main(int argc, char **argv) {
+    count = benchQuick(argc, argv) ? 100000 : 20000000;
+    static INA260SampleRing<BENCH_CAPACITY> ring;
+    static MutexRing locked;
+    const double lockFree = run(ring);
+    const double mutex = run(locked);
+    printf("%u samples through a %u-entry ring\n", count, BENCH_CAPACITY);
+    printf("INA260SampleRing %8.1f ns/sample %8.2f M samples/s\n", lockFree, 1000.0 / lockFree);
+    printf("mutex ring       %8.1f ns/sample %8.2f M samples/s\n", mutex, 1000.0 / mutex);
+    return 0;
+}
@@ -0,0 +1,138 @@
+#include <pthread.h>
+#include <stdio.h>
+
+#include "INA260SeqLock.h"
+
+#include "Bench.h"
+
+/*!
+ *  @brief Reads per second from INA260LatestSample as readers are added,
+ *  against the same sample behind a pthread mutex. One writer publishes
+ *  continuously throughout.
+*/
+
+#define BENCH_MAX_READERS 8
+
+// The baseline: readers and the writer share one lock.
+class MutexSample {
+    private:
+        mutable pthread_mutex_t mutex;
+        RawSample sample;
+
+    public:
+        MutexSample(void) : sample() {
+            pthread_mutex_init(&mutex, nullptr);
+        }
+
+        void publish(const RawSample &update) {
+            pthread_mutex_lock(&mutex);
+            sample = update;
+            pthread_mutex_unlock(&mutex);
+        }
+
+        RawSample read(void) const {
+            pthread_mutex_lock(&mutex);
+            const RawSample copy = sample;
+            pthread_mutex_unlock(&mutex);
+            return copy;
+        }
+};
+
+template <class Latest>
+struct Run {
+    Latest latest;
+    volatile bool running;
+    uint64_t reads[BENCH_MAX_READERS];
+    uint64_t torn[BENCH_MAX_READERS];
+    uint32_t writes;
+};
+
+// Every field is derived from the timestamp, so a torn copy shows.
+static RawSample make(uint32_t sequence) {
+    const RawSample sample = {
+        sequence,
+        static_cast<uint16_t>(sequence),
+        static_cast<uint16_t>(~sequence),
+        static_cast<uint16_t>(sequence >> 16),
+        0
+    };
+    return sample;
+}
+
+template <class Latest>
+static void *publishLoop(void *context) {
+    Run<Latest> *run = static_cast<Run<Latest> *>(context);
+    uint32_t sequence = 0;
+    while (run->running) {
+        run->latest.publish(make(++sequence));
+    }
+    run->writes = sequence;
+    return nullptr;
+}
+
+template <class Latest>
+struct Reader {
+    Run<Latest> *run;
+    unsigned int index;
+};
+
+template <class Latest>
+static void *readLoop(void *context) {
+    Reader<Latest> *reader = static_cast<Reader<Latest> *>(context);
+    Run<Latest> *run = reader->run;
+    uint64_t reads = 0;
+    uint64_t torn = 0;
+    while (run->running) {
+        const RawSample sample = run->latest.read();
+        const RawSample reference = make(sample.micros);
+        torn += (sample.current != reference.current || sample.voltage != reference.voltage ||
+                 sample.power != reference.power);
+        reads++;
+    }
+    run->reads[reader->index] = reads;
+    run->torn[reader->index] = torn;
+    return nullptr;
+}
+
+template <class Latest>
+static void measure(const char *name, unsigned int readers, uint32_t millis) {
+    static Run<Latest> run;
+    run.running = true;
+    Reader<Latest> contexts[BENCH_MAX_READERS];
+    pthread_t threads[BENCH_MAX_READERS];
+    pthread_t writer;
+
+    const uint64_t start = benchNanos();
+    pthread_create(&writer, nullptr, publishLoop<Latest>, &run);
+    for (unsigned int i = 0; i < readers; i++) {
+        contexts[i].run = &run;
+        contexts[i].index = i;
+        pthread_create(&threads[i], nullptr, readLoop<Latest>, &contexts[i]);
+    }
+    const struct timespec duration = { static_cast<time_t>(millis / 1000), static_cast<long>(millis % 1000) * 1000000L };
+    nanosleep(&duration, nullptr);
+    run.running = false;
+    for (unsigned int i = 0; i < readers; i++) {
+        pthread_join(threads[i], nullptr);
+    }
+    pthread_join(writer, nullptr);
+    const double seconds = static_cast<double>(benchNanos() - start) / 1e9;
+
+    uint64_t reads = 0;
+    uint64_t torn = 0;
+    for (unsigned int i = 0; i < readers; i++) {
+        reads += run.reads[i];
+        torn += run.torn[i];
+    }
+    printf("%-13s %u readers %10.2f M reads/s %10.2f M writes/s %llu torn\n", name, readers,
+           reads / seconds / 1e6, run.writes / seconds / 1e6, static_cast<unsigned long long>(torn));
+}
+
+int main(int argc, char **argv) {
+    const uint32_t millis = benchQuick(argc, argv) ? 20 : 500;
+    for (unsigned int readers = 1; readers <= BENCH_MAX_READERS; readers *= 2) {
+        measure<INA260LatestSample>("seqlock", readers, millis);
+        measure<MutexSample>("mutex", readers, millis);
+    }
+    return 0;
+}
@@ -0,0 +1,98 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "INA260ShardedAcquisition.h"
+#include "SimulatedTransport.h"
+
+#include "Bench.h"
+
+/*!
+ *  @brief Samples per second from INA260ShardedAcquisition with 1, 2
+ *  and 4 buses of 16 devices. The simulated buses run at 400 kHz in
+ *  real time, so each transaction blocks its worker the way an i2c-dev
+ *  ioctl does and the rate should grow with the number of buses.
+ *
+ *  Worker n asks for CPU n; with --realtime it also asks for SCHED_FIFO.
+ *  The table shows which requests were granted.
+*/
+
+#define BENCH_BUSES 4
+#define BENCH_DEVICES 16
+
+typedef SimulatedTransport<BENCH_DEVICES> Bus;
+
+static Bus buses[BENCH_BUSES];
+static INA260Model *models[BENCH_BUSES][BENCH_DEVICES];
+
+static void setUp(void) {
+    for (uint8_t bus = 0; bus < BENCH_BUSES; bus++) {
+        buses[bus].setBusClock(400000);
+        buses[bus].setRealTime(true);
+        for (uint8_t device = 0; device < BENCH_DEVICES; device++) {
+            models[bus][device] = new INA260Model(0x40 + device);
+            models[bus][device]->setConstant(100000 * (device + 1), 5000000);
+            buses[bus].attach(*models[bus][device]);
+        }
+    }
+}
+
+static double measure(uint8_t busCount, uint32_t millis, int priority) {
+    INA260ShardedAcquisition<Bus, BENCH_BUSES, BENCH_DEVICES> acquisition;
+    uint8_t addresses[BENCH_DEVICES];
+    for (uint8_t device = 0; device < BENCH_DEVICES; device++) {
+        addresses[device] = 0x40 + device;
+    }
+    for (uint8_t bus = 0; bus < busCount; bus++) {
+        acquisition.addBus(buses[bus], addresses, BENCH_DEVICES, 0, bus, priority);
+    }
+
+    uint64_t samples = 0;
+    uint64_t perBus[BENCH_BUSES] = {};
+    BusSample sample;
+    if (! acquisition.start()) {
+        printf("%u buses: workers did not start\n", busCount);
+        return 0.0;
+    }
+    const uint64_t start = benchNanos();
+    while (benchNanos() - start < millis * 1000000ULL) {
+        while (acquisition.next(sample)) {
+            samples++;
+            perBus[sample.bus]++;
+        }
+        ina260SleepMicros(500);
+    }
+    acquisition.stop();
+    const double seconds = static_cast<double>(benchNanos() - start) / 1e9;
+    while (acquisition.next(sample)) {
+        samples++;
+        perBus[sample.bus]++;
+    }
+
+    const double rate = samples / seconds;
+    printf("%u bus%s %10.0f samples/s  ", busCount, (busCount == 1) ? "  " : "es", rate);
+    for (uint8_t bus = 0; bus < busCount; bus++) {
+        printf(" bus %u: %6.0f/s%s%s", bus, perBus[bus] / seconds,
+               acquisition.isPinned(bus) ? " pinned" : " unpinned",
+               acquisition.isRealtime(bus) ? " fifo" : "");
+    }
+    printf("\n");
+    return rate;
+}
+
+int main(int argc, char **argv) {
+    const uint32_t millis = benchQuick(argc, argv) ? 100 : 1000;
+    int priority = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--realtime") == 0) {
+            priority = 10;
+        }
+    }
+    setUp();
+    const double one = measure(1, millis, priority);
+    measure(2, millis, priority);
+    const double four = measure(4, millis, priority);
+    if (one > 0.0) {
+        printf("4 buses / 1 bus: x%.2f\n", four / one);
+    }
+    return 0;
+}
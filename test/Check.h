@@ -0,0 +1,37 @@
+#ifndef Check_h
+#define Check_h
+
+#include <stdio.h>
+
+/*!
+ *  @brief Minimal assertions for the host tests. A failed check prints
+ *  its location and the test carries on; checkResult() is the exit code.
+*/
+static int checkFailures = 0;
+
+#define CHECK(condition) do { \
+        if (! (condition)) { \
+            printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+            checkFailures++; \
+        } \
+    } while (0)
+
+#define CHECK_EQUAL(expected, actual) do { \
+        const long long expectedValue = (expected); \
+        const long long actualValue = (actual); \
+        if (expectedValue != actualValue) { \
+            printf("%s:%d: %s is %lld, expected %lld\n", __FILE__, __LINE__, #actual, actualValue, expectedValue); \
+            checkFailures++; \
+        } \
+    } while (0)
+
+static inline int checkResult(void) {
+    if (checkFailures) {
+        printf("%d check(s) failed\n", checkFailures);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
+
+#endif // Check.H
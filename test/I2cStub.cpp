@@ -0,0 +1,223 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+#include "I2cStub.h"
+
+namespace {
+
+struct Device {
+    uint8_t address;
+    uint8_t pointer;
+    uint16_t registers[256];
+};
+
+Device devices[I2C_STUB_MAX_DEVICES];
+uint8_t deviceCount = 0;
+bool configured = false;
+int stubFd = -1;
+int selected = -1;
+uint32_t calls = 0;
+
+Device *find(int address) {
+    for (uint8_t i = 0; i < deviceCount; i++) {
+        if (devices[i].address == address) {
+            return &devices[i];
+        }
+    }
+    return nullptr;
+}
+
+void configure(void) {
+    if (configured) {
+        return;
+    }
+    configured = true;
+    const char *list = getenv("I2C_STUB_ADDRESSES");
+    while (list != nullptr && *list != '\0') {
+        char *end;
+        const long address = strtol(list, &end, 0);
+        if (end == list) {
+            break;
+        }
+        i2cStubAddDevice(static_cast<uint8_t>(address));
+        list = (*end == ',') ? end + 1 : end;
+    }
+    if (deviceCount == 0) {
+        i2cStubAddDevice(0x40);
+    }
+}
+
+// The kernel round trip each emulated call stands in for.
+void enterKernel(void) {
+    calls++;
+    syscall(SYS_getppid);
+}
+
+bool transfer(struct i2c_msg &msg) {
+    Device *device = find(msg.addr);
+    if (device == nullptr) {
+        return false;
+    }
+    if (msg.flags & I2C_M_RD) {
+        const uint16_t value = device->registers[device->pointer];
+        for (uint16_t i = 0; i < msg.len; i++) {
+            msg.buf[i] = (i & 1) ? (value & 0xFF) : (value >> 8);
+        }
+    } else if (msg.len > 0) {
+        device->pointer = msg.buf[0];
+        if (msg.len >= 3) {
+            device->registers[device->pointer] = (static_cast<uint16_t>(msg.buf[1]) << 8) | msg.buf[2];
+        }
+    }
+    return true;
+}
+
+int openStub(int flags) {
+    configure();
+    const int fd = syscall(SYS_openat, AT_FDCWD, "/dev/null", flags);
+    if (fd >= 0) {
+        stubFd = fd;
+        selected = -1;
+    }
+    return fd;
+}
+
+int openFile(const char *path, int flags, va_list args) {
+    mode_t mode = 0;
+    if (flags & O_CREAT) {
+        mode = va_arg(args, mode_t);
+    }
+    if (strcmp(path, I2C_STUB_PATH) == 0) {
+        return openStub(flags);
+    }
+    return syscall(SYS_openat, AT_FDCWD, path, flags, mode);
+}
+
+} // namespace
+
+extern "C" {
+
+bool i2cStubAddDevice(uint8_t address) {
+    configured = true;
+    if (deviceCount >= I2C_STUB_MAX_DEVICES || find(address) != nullptr) {
+        return false;
+    }
+    Device &device = devices[deviceCount++];
+    memset(&device, 0, sizeof(device));
+    device.address = address;
+    device.registers[0x00] = 0x6127; // Configuration at reset
+    device.registers[0x01] = 0x0320; // 1 A
+    device.registers[0x02] = 0x2580; // 12 V
+    device.registers[0x03] = 0x04B0; // 12 W
+    device.registers[0x06] = 0x0008; // Conversion ready
+    device.registers[0xFE] = 0x5449;
+    device.registers[0xFF] = 0x2270;
+    return true;
+}
+
+bool i2cStubSetRegister(uint8_t address, uint8_t reg, uint16_t value) {
+    configure();
+    Device *device = find(address);
+    if (device == nullptr) {
+        return false;
+    }
+    device->registers[reg] = value;
+    return true;
+}
+
+uint32_t i2cStubCallCount(void) {
+    return calls;
+}
+
+int open(const char *path, int flags, ...) {
+    va_list args;
+    va_start(args, flags);
+    const int fd = openFile(path, flags, args);
+    va_end(args);
+    return fd;
+}
+
+int open64(const char *path, int flags, ...) {
+    va_list args;
+    va_start(args, flags);
+    const int fd = openFile(path, flags, args);
+    va_end(args);
+    return fd;
+}
+
+int close(int fd) {
+    if (fd == stubFd) {
+        stubFd = -1;
+    }
+    return syscall(SYS_close, fd);
+}
+
+ssize_t write(int fd, const void *data, size_t length) {
+    if (fd != stubFd) {
+        return syscall(SYS_write, fd, data, length);
+    }
+    enterKernel();
+    struct i2c_msg msg = { static_cast<__u16>(selected), 0, static_cast<__u16>(length),
+                           static_cast<__u8 *>(const_cast<void *>(data)) };
+    if (! transfer(msg)) {
+        errno = ENXIO;
+        return -1;
+    }
+    return length;
+}
+
+ssize_t read(int fd, void *data, size_t length) {
+    if (fd != stubFd) {
+        return syscall(SYS_read, fd, data, length);
+    }
+    enterKernel();
+    struct i2c_msg msg = { static_cast<__u16>(selected), I2C_M_RD, static_cast<__u16>(length),
+                           static_cast<__u8 *>(data) };
+    if (! transfer(msg)) {
+        errno = ENXIO;
+        return -1;
+    }
+    return length;
+}
+
+int ioctl(int fd, unsigned long request, ...) {
+    va_list args;
+    va_start(args, request);
+    void *argument = va_arg(args, void *);
+    va_end(args);
+    if (fd != stubFd) {
+        return syscall(SYS_ioctl, fd, request, argument);
+    }
+    enterKernel();
+    switch (request) {
+        case I2C_SLAVE:
+        case I2C_SLAVE_FORCE:
+            selected = static_cast<int>(reinterpret_cast<long>(argument));
+            return 0;
+        case I2C_FUNCS:
+            *static_cast<unsigned long *>(argument) = I2C_FUNC_I2C;
+            return 0;
+        case I2C_RDWR: {
+            struct i2c_rdwr_ioctl_data *xfer = static_cast<struct i2c_rdwr_ioctl_data *>(argument);
+            for (__u32 i = 0; i < xfer->nmsgs; i++) {
+                if (! transfer(xfer->msgs[i])) {
+                    errno = ENXIO;
+                    return -1;
+                }
+            }
+            return xfer->nmsgs;
+        }
+        default:
+            errno = ENOTTY;
+            return -1;
+    }
+}
+
+} // extern "C"
@@ -0,0 +1,34 @@
+#ifndef I2cStub_h
+#define I2cStub_h
+
+#include <stdint.h>
+
+#define I2C_STUB_PATH                   "/dev/i2c-stub" // Path the stub answers on
+#define I2C_STUB_MAX_DEVICES            16
+
+/*!
+ *  @brief i2c-dev stand-in for running LinuxI2cTransport without an
+ *  adapter or the kernel's i2c-stub module.
+ *
+ *  The library interposes open(), close(), read(), write() and ioctl().
+ *  Opening I2C_STUB_PATH returns a descriptor on which I2C_SLAVE,
+ *  I2C_RDWR, read() and write() are served by emulated INA260 register
+ *  files with the chip's pointer semantics; every other path and
+ *  descriptor goes to the kernel unchanged. Each emulated call still
+ *  makes one real system call, so wall time includes a kernel round
+ *  trip. Link it into a program, or LD_PRELOAD it.
+ *
+ *  One INA260 answers at 0x40 until i2cStubAddDevice() is called; the
+ *  environment variable I2C_STUB_ADDRESSES (e.g. "0x40,0x45") sets the
+ *  devices for LD_PRELOAD use.
+*/
+extern "C" {
+    // Adds an INA260 with its reset register values, 1 A, 12 V and 12 W.
+    bool i2cStubAddDevice(uint8_t address);
+    // Sets a register of an emulated device.
+    bool i2cStubSetRegister(uint8_t address, uint8_t reg, uint16_t value);
+    // Number of calls served for the stub descriptor.
+    uint32_t i2cStubCallCount(void);
+}
+
+#endif // I2cStub.H
@@ -0,0 +1,88 @@
+#include "INA260.h"
+#include "INA260Alert.h"
+#include "INA260Model.h"
+#include "SimulatedAlertPin.h"
+#include "SimulatedTransport.h"
+
+#include "Check.h"
+
+/*!
+ *  @brief INA260AlertAcquisition on the device model: no lost edges when
+ *  polls are far apart, missed conversions counted from edge times, and
+ *  failed reads retried.
+*/
+
+typedef SimulatedTransport<1> Bus;
+
+static Bus bus;
+static INA260Model model;
+static INA260Device<Bus> ina(bus);
+static SimulatedAlertPin<1> pin(bus, model);
+static INA260AlertAcquisition<Bus, SimulatedAlertPin<1> > acquisition(ina, pin);
+
+static uint32_t virtualMicros(void) {
+    return static_cast<uint32_t>(bus.now());
+}
+
+static void everyConversionIsSampledWhenPolledInTime(void) {
+    INA260AlertAcquisition<Bus, SimulatedAlertPin<1> > timely(ina, pin, virtualMicros);
+    CHECK(timely.begin());
+    Snapshot snapshot;
+    for (uint8_t i = 0; i < 20; i++) {
+        CHECK(timely.poll(snapshot, 10000));
+    }
+    CHECK_EQUAL(20, timely.getSampleCount());
+    CHECK_EQUAL(0, timely.getMissedCount());
+    CHECK(timely.getLatency().maxMicros <= 10);
+}
+
+static void slowPollsLoseNoEdges(void) {
+    CHECK(acquisition.begin());
+    Snapshot snapshot;
+    bus.advance(3000);
+    CHECK(acquisition.poll(snapshot));
+
+    // 2.2 ms conversions, polled every 22 ms: one edge per poll, and the
+    // nine conversions behind each held ALERT counted as missed once the
+    // next edge shows how long it was held.
+    for (uint8_t i = 0; i < 10; i++) {
+        bus.advance(22000);
+        CHECK(acquisition.poll(snapshot));
+        CHECK(! acquisition.poll(snapshot));
+    }
+    CHECK_EQUAL(11, acquisition.getSampleCount());
+    CHECK_EQUAL(9 * 9, acquisition.getMissedCount());
+}
+
+static void edgesAfterAReleaseByAnotherReaderAreSeen(void) {
+    Snapshot snapshot;
+    bus.advance(3000);
+    // Someone else reads the flags and releases ALERT; the next
+    // conversion asserts it again before the acquisition looks.
+    ina.clearAlert();
+    bus.advance(2200);
+    CHECK(acquisition.poll(snapshot));
+}
+
+static void failedReadsKeepTheEdgePending(void) {
+    Snapshot snapshot;
+    bus.advance(3000);
+    ina.setAddress(0x41);
+    CHECK(! acquisition.poll(snapshot));
+    ina.setAddress(0x40);
+    CHECK(acquisition.poll(snapshot));
+}
+
+int main(void) {
+    model.setConstant(1000000, 12000000);
+    bus.attach(model);
+    // Reads take no virtual time, so the timings below are exact.
+    CHECK(ina.begin());
+    bus.advance(100);
+
+    everyConversionIsSampledWhenPolledInTime();
+    slowPollsLoseNoEdges();
+    edgesAfterAReleaseByAnotherReaderAreSeen();
+    failedReadsKeepTheEdgePending();
+    return checkResult();
+}
@@ -0,0 +1,163 @@
+#include "INA260.h"
+#include "INA260Async.h"
+#include "MockTransport.h"
+
+#include "Check.h"
+
+/*!
+ *  @brief INA260AsyncReader against MockTransport transfers that finish
+ *  after asyncDelay polls: state sequence, failures, the completion
+ *  callback and snapshot().
+*/
+
+typedef MockTransport<1> Bus;
+typedef INA260AsyncReader<Bus> Reader;
+
+static uint32_t callbacks;
+static AsyncState lastCallbackState;
+
+static void countCallback(Reader &reader, void *) {
+    callbacks++;
+    lastCallbackState = reader.getState();
+}
+
+static void setUp(Bus &bus, Reader &reader) {
+    Bus::Device *device = bus.addDevice(INA260_I2CADDR_DEFAULT);
+    device->registers[INA260_MASK_ENABLE_REGISTER] = 0x0008;
+    device->registers[INA260_CURRENT_REGISTER] = 0x0320;
+    device->registers[INA260_VOLTAGE_REGISTER] = 0x2580;
+    device->registers[INA260_POWER_REGISTER] = 0x0078;
+    bus.asyncDelay = 2;
+    callbacks = 0;
+    reader.onComplete(countCallback);
+}
+
+static void busyThenDoneOnce(void) {
+    Bus bus;
+    INA260Device<Bus> ina(bus);
+    Reader reader(ina);
+    setUp(bus, reader);
+
+    CHECK_EQUAL(ASYNC_IDLE, reader.getState());
+    CHECK(reader.start(INA260_CURRENT_REGISTER));
+    CHECK_EQUAL(ASYNC_BUSY, reader.step());
+    CHECK_EQUAL(ASYNC_BUSY, reader.step());
+    CHECK_EQUAL(0, callbacks);
+    CHECK_EQUAL(ASYNC_DONE, reader.step());
+    CHECK_EQUAL(1, callbacks);
+    CHECK_EQUAL(ASYNC_DONE, lastCallbackState);
+    CHECK_EQUAL(1, bus.writeReads);
+
+    // The final state is sticky and the callback does not run again.
+    CHECK_EQUAL(ASYNC_DONE, reader.step());
+    CHECK_EQUAL(1, callbacks);
+    CHECK_EQUAL(1, bus.writeReads);
+    CHECK_EQUAL(STATUS_OK, reader.result().status);
+    CHECK_EQUAL(0x0320, reader.result().value);
+}
+
+static void snapshotReadsFourRegisters(void) {
+    Bus bus;
+    INA260Device<Bus> ina(bus);
+    Reader reader(ina);
+    setUp(bus, reader);
+
+    CHECK(reader.startSnapshot());
+    uint32_t steps = 0;
+    while (reader.step() == ASYNC_BUSY) {
+        steps++;
+    }
+    CHECK_EQUAL(4 * 3 - 1, steps);
+    CHECK_EQUAL(1, callbacks);
+    Snapshot snapshot;
+    CHECK(reader.snapshot(snapshot));
+    CHECK_EQUAL(0x0008, snapshot.flags.rawValue);
+    CHECK_EQUAL(0x0320, snapshot.current);
+    CHECK_EQUAL(0x2580, snapshot.voltage);
+    CHECK_EQUAL(0x0078, snapshot.power);
+}
+
+static void failureMidList(void) {
+    Bus bus;
+    INA260Device<Bus> ina(bus);
+    Reader reader(ina);
+    setUp(bus, reader);
+
+    CHECK(reader.startSnapshot());
+    // Let the first two registers complete, then fail the third.
+    while (bus.writeReads < 2) {
+        CHECK_EQUAL(ASYNC_BUSY, reader.step());
+    }
+    bus.failNext = 1;
+    AsyncState state;
+    while ((state = reader.step()) == ASYNC_BUSY) {
+    }
+    CHECK_EQUAL(ASYNC_FAILED, state);
+    CHECK_EQUAL(1, callbacks);
+    CHECK_EQUAL(ASYNC_FAILED, lastCallbackState);
+    CHECK_EQUAL(STATUS_OK, reader.result(0).status);
+    CHECK_EQUAL(0x0008, reader.result(0).value);
+    CHECK_EQUAL(STATUS_OK, reader.result(1).status);
+    CHECK_EQUAL(0x0320, reader.result(1).value);
+    CHECK_EQUAL(STATUS_READ_FAILED, reader.result(2).status);
+    CHECK_EQUAL(STATUS_READ_FAILED, reader.result(3).status);
+    Snapshot snapshot;
+    CHECK(! reader.snapshot(snapshot));
+    CHECK_EQUAL(ASYNC_FAILED, reader.step());
+    CHECK_EQUAL(1, callbacks);
+}
+
+static void refusedStart(void) {
+    Bus bus;
+    INA260Device<Bus> ina(bus);
+    Reader reader(ina);
+    setUp(bus, reader);
+
+    // Another transfer holds the bus.
+    uint8_t data[2];
+    CHECK(bus.startRead(INA260_I2CADDR_DEFAULT, data, 2));
+    CHECK(! reader.start(INA260_CURRENT_REGISTER));
+    CHECK_EQUAL(ASYNC_FAILED, reader.getState());
+    CHECK_EQUAL(0, callbacks);
+
+    // A second start while the reader is busy is refused as well.
+    while (bus.poll() == TRANSFER_BUSY) {
+    }
+    CHECK(reader.start(INA260_CURRENT_REGISTER));
+    CHECK(! reader.start(INA260_VOLTAGE_REGISTER));
+    CHECK_EQUAL(ASYNC_BUSY, reader.getState());
+    while (reader.step() == ASYNC_BUSY) {
+    }
+    CHECK_EQUAL(1, callbacks);
+    CHECK_EQUAL(0x0320, reader.result().value);
+}
+
+static void snapshotNeedsTheSnapshotRegisters(void) {
+    Bus bus;
+    INA260Device<Bus> ina(bus);
+    Reader reader(ina);
+    setUp(bus, reader);
+
+    const uint8_t regs[4] = {
+        INA260_MASK_ENABLE_REGISTER,
+        INA260_VOLTAGE_REGISTER,
+        INA260_CURRENT_REGISTER,
+        INA260_POWER_REGISTER
+    };
+    CHECK(reader.start(regs, 4));
+    while (reader.step() == ASYNC_BUSY) {
+    }
+    CHECK_EQUAL(ASYNC_DONE, reader.getState());
+    Snapshot snapshot;
+    CHECK(! reader.snapshot(snapshot));
+    CHECK_EQUAL(0x2580, reader.result(1).value);
+}
+
+int main(void) {
+    busyThenDoneOnce();
+    snapshotReadsFourRegisters();
+    failureMidList();
+    refusedStart();
+    snapshotNeedsTheSnapshotRegisters();
+    return checkResult();
+}
@@ -0,0 +1,125 @@
+#include "INA260BusTiming.h"
+#include "SimulatedTransport.h"
+
+#include "Check.h"
+
+/*!
+ *  @brief INA260BusTiming predictions at 100 kHz and 400 kHz, against
+ *  the clock and byte arithmetic and against the time SimulatedTransport
+ *  charges for the same driver calls.
+*/
+
+static const TransactionPattern READ = { 1, 0, 0 };
+static const TransactionPattern CACHED_READ = { 0, 1, 0 };
+static const TransactionPattern WRITE = { 0, 0, 1 };
+
+static void transactionTimes(void) {
+    // S addr reg Sr addr msb lsb P: 48 clocks.
+    CHECK_EQUAL(480000, transactionNanos(READ, BUS_STANDARD));
+    CHECK_EQUAL(120000, transactionNanos(READ, BUS_FAST));
+    // S addr msb lsb P: 29 clocks.
+    CHECK_EQUAL(290000, transactionNanos(CACHED_READ, BUS_STANDARD));
+    CHECK_EQUAL(72500, transactionNanos(CACHED_READ, BUS_FAST));
+    // S addr reg msb lsb P: 38 clocks.
+    CHECK_EQUAL(380000, transactionNanos(WRITE, BUS_STANDARD));
+    CHECK_EQUAL(95000, transactionNanos(WRITE, BUS_FAST));
+
+    const TransactionPattern mixed = { 2, 3, 1 };
+    CHECK_EQUAL((2 * 48 + 3 * 29 + 38) * 10000, transactionNanos(mixed, BUS_STANDARD));
+    CHECK_EQUAL(0, transactionNanos(mixed, 0));
+
+    const TransactionPattern measurements = transactionPattern(CALL_READ_MEASUREMENTS);
+    CHECK_EQUAL(3, measurements.reads);
+    CHECK_EQUAL(1440000, transactionNanos(measurements, BUS_STANDARD));
+    CHECK_EQUAL(360000, transactionNanos(measurements, BUS_FAST));
+}
+
+static void throughput(void) {
+    ConfigurationRegister config;
+    config.rawValue = INA260_CONFIG_DEFAULT;           // 1.1 ms + 1.1 ms, no averaging
+    DeviceLoad devices[4];
+    for (uint8_t i = 0; i < 4; i++) {
+        devices[i].config = config;
+        devices[i].pattern = transactionPattern(CALL_READ_MEASUREMENTS);
+        devices[i].pollMilliHz = 100000;               // 100 Hz
+    }
+    DeviceCapacity capacities[4];
+
+    // 100 kHz: 4 x 1.44 ms per round.
+    BusPrediction prediction = predictBusLoad(devices, 4, BUS_STANDARD, capacities);
+    CHECK_EQUAL(1000000000000ULL / (4 * 1440000), prediction.maxCommonMilliHz);
+    CHECK_EQUAL(576, prediction.occupancy);            // 400 samples/s x 1.44 ms
+    CHECK(! prediction.overloaded);
+    CHECK_EQUAL(0, prediction.oversampled);
+    CHECK_EQUAL(1000000000 / 2200, capacities[0].conversionMilliHz);
+    CHECK_EQUAL(prediction.maxCommonMilliHz, capacities[0].maxMilliHz);
+    CHECK_EQUAL(1440000, capacities[0].sampleNanos);
+
+    // 400 kHz: the devices, not the bus, set the limit.
+    prediction = predictBusLoad(devices, 4, BUS_FAST, capacities);
+    CHECK_EQUAL(1000000000000ULL / (4 * 360000), prediction.maxCommonMilliHz);
+    CHECK_EQUAL(144, prediction.occupancy);
+    CHECK_EQUAL(1000000000 / 2200, capacities[3].maxMilliHz);
+
+    // As fast as possible at 100 kHz fills the bus and outruns the device.
+    for (uint8_t i = 0; i < 4; i++) {
+        devices[i].pollMilliHz = 0;
+    }
+    prediction = predictBusLoad(devices, 4, BUS_STANDARD, capacities);
+    CHECK_EQUAL(999, prediction.occupancy);
+    CHECK(! prediction.overloaded);
+    devices[0].pollMilliHz = 1000000;                  // 1 kHz on top
+    prediction = predictBusLoad(devices, 4, BUS_STANDARD, capacities);
+    CHECK(prediction.overloaded);
+    CHECK_EQUAL(1, prediction.oversampled);
+    CHECK(capacities[0].oversampled);
+}
+
+// Simulated bus time of the transaction, rounded up to microseconds.
+static uint64_t charged(TransactionPattern pattern, uint32_t busHz) {
+    const uint64_t one[3] = {
+        (transactionNanos(READ, busHz) + 999) / 1000,
+        (transactionNanos(CACHED_READ, busHz) + 999) / 1000,
+        (transactionNanos(WRITE, busHz) + 999) / 1000
+    };
+    return pattern.reads * one[0] + pattern.cachedReads * one[1] + pattern.writes * one[2];
+}
+
+static void simulatedBusAgrees(uint32_t busHz) {
+    SimulatedTransport<1> bus;
+    INA260Model model;
+    bus.attach(model);
+    bus.setBusClock(busHz);
+    INA260Device<SimulatedTransport<1> > ina(bus);
+    Snapshot snapshot;
+
+    uint64_t before = bus.now();
+    ina.readCurrent();
+    CHECK_EQUAL(charged(transactionPattern(CALL_READ_REGISTER), busHz), bus.now() - before);
+    before = bus.now();
+    ina.readCurrent();
+    CHECK_EQUAL(charged(transactionPattern(CALL_READ_REGISTER_CACHED), busHz), bus.now() - before);
+    before = bus.now();
+    ina.readBusVoltage();
+    ina.readPower();
+    ina.readCurrent();
+    CHECK_EQUAL(charged(transactionPattern(CALL_READ_MEASUREMENTS), busHz), bus.now() - before);
+    before = bus.now();
+    ina.readSnapshot(snapshot);
+    CHECK_EQUAL(charged(transactionPattern(CALL_READ_SNAPSHOT), busHz), bus.now() - before);
+    before = bus.now();
+    ina.setAveragingCount(AVG_4);
+    CHECK_EQUAL(charged(transactionPattern(CALL_SET_FIELD), busHz), bus.now() - before);
+    CHECK(ina.setShadowRegisters(true));
+    before = bus.now();
+    ina.setAveragingCount(AVG_1);
+    CHECK_EQUAL(charged(transactionPattern(CALL_SET_FIELD_SHADOWED), busHz), bus.now() - before);
+}
+
+int main(void) {
+    transactionTimes();
+    throughput();
+    simulatedBusAgrees(BUS_STANDARD);
+    simulatedBusAgrees(BUS_FAST);
+    return checkResult();
+}
@@ -0,0 +1,97 @@
+#include "INA260Integrator.h"
+
+#include "Check.h"
+
+/*!
+ *  @brief INA260Integrator totals for known constant inputs, reverse
+ *  current, gaps and readAndReset().
+*/
+
+#define ONE_AMP         0x0320 // 1000 mA at 1.25 mA/LSB
+#define MINUS_ONE_AMP   0xFCE0
+#define ONE_WATT        0x0064 // 1 W at 10 mW/LSB
+
+// One second of samples every millisecond, starting at start.
+static uint32_t addSecond(INA260Integrator &integrator, uint16_t current, uint16_t power, uint32_t start) {
+    for (uint32_t t = 0; t <= 1000000; t += 1000) {
+        integrator.add(current, power, start + t);
+    }
+    return start + 1000000;
+}
+
+static void constantCurrentAndPower(void) {
+    INA260Integrator integrator;
+    addSecond(integrator, ONE_AMP, ONE_WATT, 0);
+    const IntegratorTotals totals = integrator.read();
+    CHECK_EQUAL(1000, totals.samples);
+    CHECK_EQUAL(1000000, totals.micros);
+    CHECK_EQUAL(1000000, totals.chargeMicroCoulombs());
+    CHECK_EQUAL(1000000, totals.energyMicroJoules());
+    CHECK_EQUAL(277, totals.chargeMicroAmpHours());           // 1 C = 277.8 uAh
+    CHECK_EQUAL(277, totals.energyMicroWattHours());
+    CHECK(totals.energyJoules() == 1.0);
+    CHECK_EQUAL(0, totals.gaps);
+    CHECK_EQUAL(0, totals.gapMicros);
+}
+
+static void reverseCurrentIsNegative(void) {
+    INA260Integrator integrator;
+    addSecond(integrator, MINUS_ONE_AMP, ONE_WATT, 0);
+    IntegratorTotals totals = integrator.read();
+    CHECK_EQUAL(-1000000, totals.chargeMicroCoulombs());
+    CHECK_EQUAL(1000000, totals.energyMicroJoules());
+
+    // Charging then discharging at the same rate nets out.
+    addSecond(integrator, ONE_AMP, ONE_WATT, 1000000);
+    totals = integrator.read();
+    CHECK_EQUAL(0, totals.charge);
+    CHECK_EQUAL(2000000, totals.energyMicroJoules());
+}
+
+static void gapsAreBridgedWithTheMean(void) {
+    INA260Integrator integrator(10000);
+    integrator.add(ONE_AMP, ONE_WATT, 0);
+    integrator.add(ONE_AMP, ONE_WATT, 1000);
+    // Two seconds missing, then a sample at zero current.
+    integrator.add(0, 0, 2001000);
+    const IntegratorTotals totals = integrator.read();
+    CHECK_EQUAL(2, totals.samples);
+    CHECK_EQUAL(1, totals.gaps);
+    CHECK_EQUAL(2000000, totals.gapMicros);
+    CHECK_EQUAL(2001000, totals.micros);
+    CHECK_EQUAL(1000 + 1000000, totals.chargeMicroCoulombs());
+    CHECK_EQUAL(1000 + 1000000, totals.energyMicroJoules());
+}
+
+static void readAndResetStartsANewPeriod(void) {
+    INA260Integrator integrator;
+    uint32_t t = addSecond(integrator, ONE_AMP, ONE_WATT, 0xFFF00000);  // Crosses the clock wrap
+    const IntegratorTotals first = integrator.readAndReset();
+    CHECK_EQUAL(1000000, first.chargeMicroCoulombs());
+    CHECK_EQUAL(1000, first.samples);
+
+    IntegratorTotals totals = integrator.read();
+    CHECK_EQUAL(0, totals.charge);
+    CHECK_EQUAL(0, totals.energy);
+    CHECK_EQUAL(0, totals.micros);
+    CHECK_EQUAL(0, totals.samples);
+
+    // The next sample is integrated from the last one before the reset.
+    integrator.add(ONE_AMP, ONE_WATT, t + 500000);
+    totals = integrator.read();
+    CHECK_EQUAL(500000, totals.chargeMicroCoulombs());
+    CHECK_EQUAL(1, totals.samples);
+
+    const IntegratorTotals second = integrator.readAndReset();
+    CHECK_EQUAL(500000, second.chargeMicroCoulombs());
+    CHECK_EQUAL(500000, second.micros);
+    CHECK_EQUAL(0, integrator.read().samples);
+}
+
+int main(void) {
+    constantCurrentAndPower();
+    reverseCurrentIsNegative();
+    gapsAreBridgedWithTheMean();
+    readAndResetStartsANewPeriod();
+    return checkResult();
+}
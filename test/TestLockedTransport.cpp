@@ -0,0 +1,127 @@
+#include <pthread.h>
+#include <sched.h>
+
+#include "INA260.h"
+#include "INA260Async.h"
+#include "LockedTransport.h"
+#include "MockTransport.h"
+
+#include "Check.h"
+
+/*!
+ *  @brief LockedTransport shared by threads with their own devices:
+ *  synchronous readers with the pointer cache on different addresses,
+ *  two objects for one address with it off, and asynchronous readers
+ *  holding the bus across polls. Every value read must belong to the
+ *  register and device asked for.
+*/
+
+#define TORTURE_ROUNDS 20000
+
+typedef MockTransport<4> Bus;
+typedef LockedTransport<Bus, INA260Mutex> SharedBus;
+
+static Bus bus;
+static INA260Mutex mutex;
+static SharedBus shared(bus, mutex);
+
+// Each register of each device holds a value naming both.
+static uint16_t expected(uint8_t address, uint8_t reg) {
+    return static_cast<uint16_t>((address << 8) | reg);
+}
+
+struct Worker {
+    uint8_t address;
+    uint8_t reg;            // Second register read, alongside the current
+    bool cache;
+    uint32_t wrong;
+    uint32_t failed;
+};
+
+static void *readSync(void *context) {
+    Worker *worker = static_cast<Worker *>(context);
+    INA260Device<SharedBus> ina(shared, worker->address);
+    ina.setPointerCache(worker->cache);
+    for (uint32_t round = 0; round < TORTURE_ROUNDS; round++) {
+        const uint8_t reg = (round & 1) ? worker->reg : INA260_CURRENT_REGISTER;
+        uint16_t value;
+        if (! ina.readRegister(reg, value)) {
+            worker->failed++;
+        } else if (value != expected(worker->address, reg)) {
+            worker->wrong++;
+        }
+        if ((round & 7) == 0) {
+            sched_yield();
+        }
+    }
+    return nullptr;
+}
+
+static void *readAsync(void *context) {
+    Worker *worker = static_cast<Worker *>(context);
+    INA260Device<SharedBus> ina(shared, worker->address);
+    INA260AsyncReader<SharedBus> reader(ina);
+    for (uint32_t round = 0; round < TORTURE_ROUNDS / 4; round++) {
+        if (! reader.startSnapshot()) {
+            worker->failed++;
+            continue;
+        }
+        AsyncState state;
+        while ((state = reader.step()) == ASYNC_BUSY) {
+            sched_yield();
+        }
+        Snapshot snapshot;
+        if (state != ASYNC_DONE || ! reader.snapshot(snapshot)) {
+            worker->failed++;
+        } else if (snapshot.flags.rawValue != expected(worker->address, INA260_MASK_ENABLE_REGISTER) ||
+                   snapshot.current != expected(worker->address, INA260_CURRENT_REGISTER) ||
+                   snapshot.voltage != expected(worker->address, INA260_VOLTAGE_REGISTER) ||
+                   snapshot.power != expected(worker->address, INA260_POWER_REGISTER)) {
+            worker->wrong++;
+        }
+    }
+    return nullptr;
+}
+
+static void threadsNeverSeeEachOthersTransfers(void) {
+    for (uint8_t address = 0x40; address < 0x44; address++) {
+        Bus::Device *device = bus.addDevice(address);
+        for (uint16_t reg = 0; reg < 256; reg++) {
+            device->registers[reg] = expected(address, reg);
+        }
+    }
+    bus.asyncDelay = 2;
+
+    Worker workers[] = {
+        { 0x40, INA260_VOLTAGE_REGISTER, true, 0, 0 },
+        { 0x41, INA260_POWER_REGISTER, true, 0, 0 },
+        { 0x42, INA260_DIE_ID_REGISTER, true, 0, 0 },
+        { 0x43, INA260_VOLTAGE_REGISTER, false, 0, 0 },
+        { 0x43, INA260_POWER_REGISTER, false, 0, 0 },
+        { 0x40, 0, false, 0, 0 },
+        { 0x43, 0, false, 0, 0 },
+    };
+    const unsigned int syncWorkers = 5;
+    const unsigned int count = sizeof(workers) / sizeof(workers[0]);
+    pthread_t threads[count];
+    for (unsigned int i = 0; i < count; i++) {
+        pthread_create(&threads[i], nullptr, (i < syncWorkers) ? readSync : readAsync, &workers[i]);
+    }
+    for (unsigned int i = 0; i < count; i++) {
+        pthread_join(threads[i], nullptr);
+    }
+
+    for (unsigned int i = 0; i < count; i++) {
+        CHECK_EQUAL(0, workers[i].failed);
+        CHECK_EQUAL(0, workers[i].wrong);
+    }
+    // The mock's counters are only updated under the lock, so none are lost.
+    const uint32_t asyncTransfers = 2 * (TORTURE_ROUNDS / 4) * 4;
+    CHECK_EQUAL(syncWorkers * TORTURE_ROUNDS + asyncTransfers, bus.reads + bus.writeReads);
+    CHECK_EQUAL(TRANSFER_IDLE, shared.poll());
+}
+
+int main(void) {
+    threadsNeverSeeEachOthersTransfers();
+    return checkResult();
+}
@@ -0,0 +1,111 @@
+#include "INA260.h"
+#include "MockTransport.h"
+
+#include "Check.h"
+
+/*!
+ *  @brief The register pointer cache: transfers saved, and reads kept
+ *  correct when other objects on the transport move the pointer.
+*/
+
+typedef MockTransport<2> Bus;
+
+static void setUp(Bus &bus) {
+    for (uint8_t address = 0x40; address <= 0x41; address++) {
+        Bus::Device *device = bus.addDevice(address);
+        device->registers[INA260_CURRENT_REGISTER] = 0x0320;          // 1000 mA
+        device->registers[INA260_VOLTAGE_REGISTER] = 0x2580;          // 12 V
+        device->registers[INA260_MANUFACTURER_ID_REGISTER] = INA260_MANUFACTURER_ID;
+        device->registers[INA260_DIE_ID_REGISTER] = 0x2270;
+    }
+}
+
+static void repeatedReadsSkipThePointerWrite(void) {
+    Bus bus;
+    setUp(bus);
+    INA260Device<Bus> ina(bus, 0x40);
+
+    ina.readCurrent();
+    CHECK_EQUAL(1, bus.writeReads);
+    CHECK_EQUAL(0, bus.reads);
+    ina.readCurrent();
+    ina.readCurrent();
+    CHECK_EQUAL(1, bus.writeReads);
+    CHECK_EQUAL(2, bus.reads);
+    ina.readBusVoltage();
+    CHECK_EQUAL(2, bus.writeReads);
+    CHECK_EQUAL(2, bus.reads);
+    CHECK_EQUAL(0, bus.writes);
+
+    bus.resetCounters();
+    ina.setPointerCache(false);
+    ina.readBusVoltage();
+    ina.readBusVoltage();
+    CHECK_EQUAL(2, bus.writeReads);
+    CHECK_EQUAL(0, bus.reads);
+}
+
+static void anotherObjectMovesThePointer(void) {
+    Bus bus;
+    setUp(bus);
+    INA260Device<Bus> ina(bus, 0x40);
+    INA260Device<Bus> scanner(bus, 0x41);
+    uint8_t found[16];
+
+    CHECK(ina.readCurrent() == 1000.0f);
+    // The scan leaves 0x40 pointing at the Die ID register.
+    CHECK_EQUAL(2, scanner.scanDevices(found, 16).found);
+    bus.resetCounters();
+    CHECK(ina.readCurrent() == 1000.0f);
+    CHECK_EQUAL(1, bus.writeReads);
+    CHECK_EQUAL(0, bus.reads);
+
+    // A second object for the same address.
+    INA260Device<Bus> other(bus, 0x40);
+    other.readBusVoltage();
+    CHECK(ina.readCurrent() == 1000.0f);
+}
+
+static void oneObjectPollingSeveralAddresses(void) {
+    Bus bus;
+    setUp(bus);
+    INA260Device<Bus> ina(bus, 0x40);
+
+    for (uint8_t round = 0; round < 3; round++) {
+        for (uint8_t address = 0x40; address <= 0x41; address++) {
+            ina.setAddress(address);
+            CHECK(ina.readCurrent() == 1000.0f);
+        }
+    }
+    // One pointer write per device, then cached reads.
+    CHECK_EQUAL(2, bus.writeReads);
+    CHECK_EQUAL(4, bus.reads);
+}
+
+static void failedTransfersForgetThePointer(void) {
+    Bus bus;
+    setUp(bus);
+    INA260Device<Bus> ina(bus, 0x40);
+
+    ina.readCurrent();
+    bus.resetCounters();
+    bus.failNext = 1;
+    CHECK(! ina.tryReadCurrent().ok());
+    CHECK(ina.readCurrent() == 1000.0f);
+    CHECK_EQUAL(1, bus.writeReads);
+    CHECK_EQUAL(1, bus.reads);
+
+    // Writes move the pointer to the written register.
+    ina.setMode(MODE_CONT_ISH);
+    bus.resetCounters();
+    ina.readCurrent();
+    CHECK_EQUAL(1, bus.writeReads);
+}
+
+int main(void) {
+    repeatedReadsSkipThePointerWrite();
+    anotherObjectMovesThePointer();
+    oneObjectPollingSeveralAddresses();
+    failedTransfersForgetThePointer();
+    return checkResult();
+}
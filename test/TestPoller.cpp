@@ -0,0 +1,188 @@
+#include "INA260Poller.h"
+#include "MockTransport.h"
+#include "SimulatedTransport.h"
+
+#include "Check.h"
+
+/*!
+ *  @brief INA260Poller: sample and error counts, the schedule and missed
+ *  periods on a stepped clock, statistics reset, and rates over more
+ *  than one wrap of the 32-bit microsecond clock.
+*/
+
+static uint32_t fakeMicros = 0;
+
+static uint32_t fakeClock(void) {
+    return fakeMicros;
+}
+
+static void ratesSurviveTheClockWrap(void) {
+    MockTransport<1> bus;
+    bus.addDevice(0x40);
+    fakeMicros = 0xF0000000; // Wraps about 4.5 minutes in
+    INA260Poller<MockTransport<1> > poller(bus, fakeClock);
+    poller.addDevice(0x40, 1000000);
+
+    // Two hours at one sample a second; the mock takes no bus time.
+    for (uint32_t second = 0; second < 7200; second++) {
+        poller.poll();
+        fakeMicros += 1000000;
+    }
+    CHECK_EQUAL(7200, poller.samples().sampleCount[0]);
+    CHECK_EQUAL(1000, poller.achievedRate(0));
+    CHECK_EQUAL(0, poller.busUtilisation());
+
+    poller.resetStatistics();
+    fakeMicros += 1000000;
+    poller.poll();
+    CHECK_EQUAL(1000, poller.achievedRate(0));
+}
+
+static void failingDevicesCountErrors(void) {
+    MockTransport<1> bus;
+    MockTransport<1>::Device *chip = bus.addDevice(0x40);
+    chip->registers[INA260_CURRENT_REGISTER] = 0xFFF8;        // -10 mA
+    chip->registers[INA260_VOLTAGE_REGISTER] = 0x2580;
+    chip->registers[INA260_POWER_REGISTER] = 0x0001;
+    fakeMicros = 0;
+    INA260Poller<MockTransport<1> > poller(bus, fakeClock);
+    const uint8_t addresses[2] = { 0x40, 0x41 };                // Nothing answers at 0x41
+    CHECK_EQUAL(2, poller.addDevices(addresses, 2, 1000));
+
+    for (uint8_t i = 0; i < 10; i++) {
+        CHECK_EQUAL(1, poller.poll());
+        fakeMicros += 1000;
+    }
+    const INA260Poller<MockTransport<1> >::Samples &samples = poller.samples();
+    CHECK_EQUAL(10, samples.sampleCount[0]);
+    CHECK_EQUAL(0, samples.errorCount[0]);
+    CHECK_EQUAL(0, samples.sampleCount[1]);
+    CHECK_EQUAL(10, samples.errorCount[1]);
+    CHECK_EQUAL(-8, samples.current[0]);
+    CHECK_EQUAL(0x2580, samples.voltage[0]);
+    CHECK_EQUAL(1, samples.power[0]);
+    CHECK_EQUAL(9000, samples.timestamp[0]);
+
+    // A failed read keeps the previous values and timestamp.
+    bus.failNext = 1;
+    CHECK_EQUAL(0, poller.poll());
+    CHECK_EQUAL(10, samples.sampleCount[0]);
+    CHECK_EQUAL(1, samples.errorCount[0]);
+    CHECK_EQUAL(9000, samples.timestamp[0]);
+    CHECK_EQUAL(0, samples.missedCount[0]);
+}
+
+static void steppedClockSchedule(void) {
+    MockTransport<1> bus;
+    bus.addDevice(0x40);
+    fakeMicros = 0;
+    INA260Poller<MockTransport<1> > poller(bus, fakeClock);
+    poller.addDevice(0x40, 1000);
+    const INA260Poller<MockTransport<1> >::Samples &samples = poller.samples();
+
+    CHECK_EQUAL(1, poller.poll());            // Due at once
+    fakeMicros = 999;
+    CHECK_EQUAL(0, poller.poll());
+    fakeMicros = 1000;
+    CHECK_EQUAL(1, poller.poll());            // Exactly on time
+    fakeMicros = 3500;
+    CHECK_EQUAL(1, poller.poll());            // Late: 2000 read now, 3000 skipped
+    CHECK_EQUAL(1, samples.missedCount[0]);
+    fakeMicros = 3999;
+    CHECK_EQUAL(0, poller.poll());
+    fakeMicros = 4000;
+    CHECK_EQUAL(1, poller.poll());
+    fakeMicros = 9000;
+    CHECK_EQUAL(1, poller.poll());            // 5000 read now, 6000 to 8000 skipped, 9000 is now
+    CHECK_EQUAL(4, samples.missedCount[0]);
+    CHECK_EQUAL(5, samples.sampleCount[0]);
+    CHECK_EQUAL(9000, samples.timestamp[0]);
+
+    // Period 0 samples on every poll and never misses.
+    CHECK(poller.setPeriod(0, 0));
+    fakeMicros = 10000;
+    CHECK_EQUAL(1, poller.poll());
+    CHECK_EQUAL(1, poller.poll());
+    fakeMicros = 50000;
+    CHECK_EQUAL(1, poller.poll());
+    CHECK_EQUAL(4, samples.missedCount[0]);
+    CHECK_EQUAL(8, samples.sampleCount[0]);
+    CHECK(! poller.setPeriod(1, 0));
+}
+
+static SimulatedTransport<1> *timedBus;
+
+static uint32_t busClock(void) {
+    return static_cast<uint32_t>(timedBus->now());
+}
+
+static void readEndingOnTheNextPeriodIsNotLate(void) {
+    SimulatedTransport<1> bus;
+    INA260Model model(0x40);
+    bus.attach(model);
+    bus.setBusClock(100000);
+    timedBus = &bus;
+    // Three register reads of 3 + 9 x 5 clocks at 100 kHz.
+    const uint32_t sampleMicros = 3 * 480;
+    INA260Poller<SimulatedTransport<1> > poller(bus, busClock);
+    poller.addDevice(0x40, sampleMicros);
+
+    for (uint8_t i = 0; i < 20; i++) {
+        CHECK_EQUAL(1, poller.poll());
+    }
+    CHECK_EQUAL(20 * sampleMicros, bus.now());
+    CHECK_EQUAL(0, poller.samples().missedCount[0]);
+    CHECK_EQUAL(1000, poller.busUtilisation());
+
+    // One more microsecond of work per sample and every other period is lost.
+    poller.setPeriod(0, sampleMicros - 1);
+    poller.resetStatistics();
+    for (uint8_t i = 0; i < 20; i++) {
+        poller.poll();
+        bus.advance(sampleMicros);
+    }
+    CHECK_EQUAL(20, poller.samples().sampleCount[0]);
+    CHECK_EQUAL(20, poller.samples().missedCount[0]);
+}
+
+static void resetClearsTheStatistics(void) {
+    MockTransport<1> bus;
+    bus.addDevice(0x40);
+    fakeMicros = 0;
+    INA260Poller<MockTransport<1> > poller(bus, fakeClock);
+    const uint8_t addresses[2] = { 0x40, 0x41 };
+    poller.addDevices(addresses, 2, 1000);
+    for (uint8_t i = 0; i < 4; i++) {
+        poller.poll();
+        fakeMicros += 2500;
+    }
+    const INA260Poller<MockTransport<1> >::Samples &samples = poller.samples();
+    CHECK_EQUAL(4, samples.sampleCount[0]);
+    CHECK(samples.missedCount[0] > 0);
+    CHECK_EQUAL(4, samples.errorCount[1]);
+    CHECK_EQUAL(400000, poller.achievedRate(0));      // Millihertz
+
+    poller.resetStatistics();
+    CHECK_EQUAL(0, samples.sampleCount[0]);
+    CHECK_EQUAL(0, samples.missedCount[0]);
+    CHECK_EQUAL(0, samples.errorCount[1]);
+    CHECK_EQUAL(0, poller.achievedRate(0));
+    CHECK_EQUAL(0, poller.busUtilisation());
+    // The values read so far are kept.
+    CHECK_EQUAL(0x40, samples.address[0]);
+    CHECK_EQUAL(7500, samples.timestamp[0]);
+
+    poller.poll();
+    fakeMicros += 1000;
+    CHECK_EQUAL(1, samples.sampleCount[0]);
+    CHECK_EQUAL(1000000, poller.achievedRate(0));
+}
+
+int main(void) {
+    failingDevicesCountErrors();
+    steppedClockSchedule();
+    readEndingOnTheNextPeriodIsNotLate();
+    resetClearsTheStatistics();
+    ratesSurviveTheClockWrap();
+    return checkResult();
+}
@@ -0,0 +1,91 @@
+#include <pthread.h>
+#include <sched.h>
+
+#include "INA260SampleRing.h"
+
+#include "Check.h"
+
+/*!
+ *  @brief INA260SampleRing with a producer and a consumer thread: every
+ *  sample arrives once, in order and untorn, and full pushes are counted.
+*/
+
+#define STRESS_SAMPLES 2000000
+
+static INA260SampleRing<64> ring;
+static uint32_t rejected = 0;
+
+static RawSample make(uint32_t sequence) {
+    const RawSample sample = {
+        sequence,
+        static_cast<uint16_t>(sequence),
+        static_cast<uint16_t>(~sequence),
+        static_cast<uint16_t>(sequence >> 16),
+        static_cast<uint16_t>(sequence * 3)
+    };
+    return sample;
+}
+
+static void *produce(void *) {
+    for (uint32_t sequence = 0; sequence < STRESS_SAMPLES; sequence++) {
+        while (! ring.push(make(sequence))) {
+            rejected++;
+            sched_yield();
+        }
+    }
+    return nullptr;
+}
+
+static void samplesArriveOnceInOrder(void) {
+    pthread_t producer;
+    pthread_create(&producer, nullptr, produce, nullptr);
+
+    uint32_t expected = 0;
+    uint32_t torn = 0;
+    uint32_t outOfOrder = 0;
+    while (expected < STRESS_SAMPLES) {
+        RawSample sample = {};
+        if (! ring.pop(sample)) {
+            sched_yield();
+            continue;
+        }
+        const RawSample reference = make(sample.micros);
+        if (sample.current != reference.current || sample.voltage != reference.voltage ||
+            sample.power != reference.power || sample.flags != reference.flags) {
+            torn++;
+        }
+        if (sample.micros != expected) {
+            outOfOrder++;
+        }
+        expected = sample.micros + 1;
+    }
+    pthread_join(producer, nullptr);
+
+    CHECK_EQUAL(0, torn);
+    CHECK_EQUAL(0, outOfOrder);
+    CHECK_EQUAL(0, ring.size());
+    CHECK_EQUAL(rejected, ring.getOverflowCount());
+}
+
+static void fullRingDropsTheNewSample(void) {
+    INA260SampleRing<4> small;
+    for (uint32_t i = 0; i < 6; i++) {
+        small.push(make(i));
+    }
+    CHECK_EQUAL(4, small.size());
+    CHECK_EQUAL(2, small.getOverflowCount());
+    RawSample sample = {};
+    CHECK(small.peek(sample));
+    CHECK_EQUAL(0, sample.micros);
+    for (uint32_t i = 0; i < 4; i++) {
+        CHECK(small.pop(sample));
+        CHECK_EQUAL(i, sample.micros);
+    }
+    CHECK(! small.pop(sample));
+}
+
+int main(void) {
+    fullRingDropsTheNewSample();
+    samplesArriveOnceInOrder();
+    return checkResult();
+}
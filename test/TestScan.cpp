@@ -0,0 +1,111 @@
+#include "INA260.h"
+#include "MockTransport.h"
+#include "SimulatedTransport.h"
+
+#include "Check.h"
+
+/*!
+ *  @brief INA260Device::scanDevices(): devices that acknowledge but are
+ *  not INA260s are rejected by their ID registers.
+*/
+
+typedef MockTransport<5> Bus;
+
+static void addChip(Bus &bus, uint8_t address, uint16_t manufacturer, uint16_t die) {
+    Bus::Device *device = bus.addDevice(address);
+    device->registers[INA260_MANUFACTURER_ID_REGISTER] = manufacturer;
+    device->registers[INA260_DIE_ID_REGISTER] = die;
+}
+
+static void foreignDevicesAreRejected(void) {
+    Bus bus;
+    addChip(bus, 0x40, INA260_MANUFACTURER_ID, 0x2270);
+    addChip(bus, 0x44, 0x0000, 0x0000);                    // Answers, but has no TI IDs
+    addChip(bus, 0x45, INA260_MANUFACTURER_ID, 0x2260);    // A TI part with another die (INA226)
+    addChip(bus, 0x4F, INA260_MANUFACTURER_ID, 0x2271);    // Another INA260 revision
+    addChip(bus, 0x50, INA260_MANUFACTURER_ID, 0x2270);    // Outside the INA260 range
+    INA260Device<Bus> ina(bus, 0x4F);
+    uint8_t found[16];
+
+    const ScanResult result = ina.scanDevices(found, 16);
+    CHECK_EQUAL(2, result.found);
+    CHECK_EQUAL(0x40, found[0]);
+    CHECK_EQUAL(0x4F, found[1]);
+    CHECK_EQUAL(2, result.rejected);
+    CHECK_EQUAL(16, result.probes);
+    CHECK_EQUAL(16, bus.probes);
+    CHECK_EQUAL(8, bus.writeReads);                        // Two ID reads per device that answered
+    CHECK_EQUAL(0x4F, ina.getAddress());
+
+    // A full buffer ends the scan.
+    bus.resetCounters();
+    const ScanResult first = ina.scanDevices(found, 1);
+    CHECK_EQUAL(1, first.found);
+    CHECK_EQUAL(0x40, found[0]);
+    CHECK_EQUAL(1, first.probes);
+    CHECK_EQUAL(0, first.rejected);
+}
+
+// A bus whose reads of one register fail, e.g. a device that NAKs it.
+class FlakyBus : public Bus {
+    public:
+        uint8_t failRegister;
+
+        FlakyBus(void) : failRegister(0) {}
+
+        bool writeRead(uint8_t address, const uint8_t *out, uint8_t outLength,
+                       uint8_t *in, uint8_t inLength) {
+            if (outLength > 0 && out[0] == failRegister) {
+                writeReads++;
+                return false;
+            }
+            return Bus::writeRead(address, out, outLength, in, inLength);
+        }
+};
+
+static void failedIdReadIsRejected(void) {
+    FlakyBus bus;
+    addChip(bus, 0x41, INA260_MANUFACTURER_ID, 0x2270);
+    INA260Device<FlakyBus> ina(bus);
+    uint8_t found[16];
+
+    bus.failRegister = INA260_MANUFACTURER_ID_REGISTER;
+    ScanResult result = ina.scanDevices(found, 16);
+    CHECK_EQUAL(0, result.found);
+    CHECK_EQUAL(1, result.rejected);
+    CHECK_EQUAL(1, bus.writeReads);                        // The Die ID is not read
+
+    bus.failRegister = INA260_DIE_ID_REGISTER;
+    result = ina.scanDevices(found, 16);
+    CHECK_EQUAL(0, result.found);
+    CHECK_EQUAL(1, result.rejected);
+
+    bus.failRegister = 0;
+    result = ina.scanDevices(found, 16);
+    CHECK_EQUAL(1, result.found);
+    CHECK_EQUAL(0x41, found[0]);
+    CHECK_EQUAL(0, result.rejected);
+}
+
+static void simulatedDevicesAreFound(void) {
+    SimulatedTransport<2> bus;
+    INA260Model first(0x42);
+    INA260Model second(0x4B);
+    bus.attach(first);
+    bus.attach(second);
+    INA260Device<SimulatedTransport<2> > ina(bus);
+    uint8_t found[16];
+
+    const ScanResult result = ina.scanDevices(found, 16);
+    CHECK_EQUAL(2, result.found);
+    CHECK_EQUAL(0x42, found[0]);
+    CHECK_EQUAL(0x4B, found[1]);
+    CHECK_EQUAL(0, result.rejected);
+}
+
+int main(void) {
+    foreignDevicesAreRejected();
+    failedIdReadIsRejected();
+    simulatedDevicesAreFound();
+    return checkResult();
+}
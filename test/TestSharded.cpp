@@ -0,0 +1,63 @@
+#include <limits.h>
+
+#include "INA260ShardedAcquisition.h"
+#include "SimulatedTransport.h"
+
+#include "Check.h"
+
+/*!
+ *  @brief INA260ShardedAcquisition: addBus() refuses CPUs and priorities
+ *  the worker could not be given, and an accepted bus delivers samples.
+*/
+
+typedef SimulatedTransport<1> Bus;
+typedef INA260ShardedAcquisition<Bus, 4, 1> Acquisition;
+
+static const uint8_t addresses[1] = { 0x40 };
+
+static void outOfRangeRequestsAreRefused(void) {
+    Bus bus;
+    Acquisition acquisition;
+
+    CHECK_EQUAL(-1, acquisition.addBus(bus, addresses, 1, 1000, CPU_SETSIZE));
+    CHECK_EQUAL(-1, acquisition.addBus(bus, addresses, 1, 1000, INT_MAX));
+    CHECK_EQUAL(-1, acquisition.addBus(bus, addresses, 1, 1000, -2));
+    CHECK_EQUAL(-1, acquisition.addBus(bus, addresses, 1, 1000, -1, sched_get_priority_max(SCHED_FIFO) + 1));
+    CHECK_EQUAL(-1, acquisition.addBus(bus, addresses, 1, 1000, -1, -1));
+    CHECK_EQUAL(0, acquisition.getBusCount());
+
+    CHECK_EQUAL(0, acquisition.addBus(bus, addresses, 1, 1000, CPU_SETSIZE - 1));
+    CHECK_EQUAL(1, acquisition.addBus(bus, addresses, 1, 1000, -1, sched_get_priority_min(SCHED_FIFO)));
+    CHECK_EQUAL(2, acquisition.getBusCount());
+}
+
+static void acceptedBusDeliversSamples(void) {
+    Bus bus;
+    INA260Model model(0x40);
+    model.setConstant(250000, 12000000);
+    bus.attach(model);
+    Acquisition acquisition;
+
+    CHECK_EQUAL(0, acquisition.addBus(bus, addresses, 1, 0, 0));
+    CHECK(acquisition.start());
+    CHECK_EQUAL(-1, acquisition.addBus(bus, addresses, 1, 0));
+
+    BusSample sample = {};
+    bool received = false;
+    for (int i = 0; i < 1000 && ! received; i++) {
+        received = acquisition.next(sample);
+        if (! received) {
+            ina260SleepMicros(1000);
+        }
+    }
+    acquisition.stop();
+    CHECK(received);
+    CHECK_EQUAL(0, sample.bus);
+    CHECK_EQUAL(0x40, sample.address);
+}
+
+int main(void) {
+    outOfRangeRequestsAreRefused();
+    acceptedBusDeliversSamples();
+    return checkResult();
+}
@@ -0,0 +1,231 @@
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "INA260SharedMemory.h"
+#include "SimulatedTransport.h"
+
+#include "Check.h"
+
+/*!
+ *  @brief INA260SharedPublisher and INA260SharedClient: a publisher
+ *  thread overwriting slots the client is copying, a publisher taking
+ *  over the name from another, and a forked daemon sampling a simulated
+ *  INA260 with run().
+*/
+
+#define STRESS_SAMPLES 1000000
+#define STRESS_NAME "/ina260-test"
+
+static INA260SharedPublisher publisher(STRESS_NAME, 8);
+static volatile bool finished = false;
+
+static RawSample make(uint32_t sequence) {
+    const RawSample sample = {
+        sequence,
+        static_cast<uint16_t>(sequence),
+        static_cast<uint16_t>(~sequence),
+        static_cast<uint16_t>(sequence >> 16),
+        static_cast<uint16_t>(sequence * 3)
+    };
+    return sample;
+}
+
+static void *produce(void *) {
+    for (uint32_t sequence = 0; sequence < STRESS_SAMPLES; sequence++) {
+        publisher.publish(make(sequence));
+        if ((sequence & 15) == 0) {
+            sched_yield();
+        }
+    }
+    __atomic_store_n(&finished, true, __ATOMIC_RELEASE);
+    return nullptr;
+}
+
+static void clientSeesEverySampleOrCountsIt(void) {
+    CHECK(publisher.begin());
+    INA260SharedClient client(STRESS_NAME);
+    CHECK(client.begin());
+
+    pthread_t producer;
+    pthread_create(&producer, nullptr, produce, nullptr);
+
+    uint64_t received = 0;
+    uint32_t torn = 0;
+    uint32_t outOfOrder = 0;
+    uint32_t expected = 0;
+    RawSample sample = {};
+    for (;;) {
+        const bool done = __atomic_load_n(&finished, __ATOMIC_ACQUIRE);
+        while (client.next(sample)) {
+            const RawSample reference = make(sample.micros);
+            if (sample.current != reference.current || sample.voltage != reference.voltage ||
+                sample.power != reference.power || sample.flags != reference.flags) {
+                torn++;
+            }
+            if (sample.micros < expected) {
+                outOfOrder++;
+            }
+            expected = sample.micros + 1;
+            received++;
+        }
+        if (done) {
+            break;
+        }
+        sched_yield();
+    }
+    pthread_join(producer, nullptr);
+
+    CHECK_EQUAL(0, torn);
+    CHECK_EQUAL(0, outOfOrder);
+    CHECK_EQUAL(STRESS_SAMPLES, client.getPosition());
+    CHECK_EQUAL(STRESS_SAMPLES, received + client.getLostCount());
+    CHECK(client.latest(sample));
+    CHECK_EQUAL(STRESS_SAMPLES - 1, sample.micros);
+    client.end();
+    publisher.end();
+}
+
+static void newPublisherLeavesOldClientsAlone(void) {
+    INA260SharedPublisher first(STRESS_NAME, 64);
+    CHECK(first.begin());
+    INA260SharedClient client(STRESS_NAME);
+    CHECK(client.begin());
+    for (uint32_t i = 0; i < 5; i++) {
+        first.publish(make(i));
+    }
+
+    // A second publisher with a smaller ring gets a segment of its own.
+    INA260SharedPublisher second(STRESS_NAME, 8);
+    CHECK(second.begin());
+    for (uint32_t i = 100; i < 120; i++) {
+        second.publish(make(i));
+    }
+    RawSample sample = {};
+    uint32_t received = 0;
+    while (client.next(sample)) {
+        CHECK_EQUAL(received, sample.micros);
+        received++;
+    }
+    CHECK_EQUAL(5, received);
+    CHECK_EQUAL(0, client.getLostCount());
+
+    // Ending the first publisher does not remove the second's name.
+    first.end();
+    INA260SharedClient late(STRESS_NAME);
+    CHECK(late.begin());
+    second.publish(make(120));
+    CHECK(late.next(sample));
+    CHECK_EQUAL(120, sample.micros);
+    late.end();
+    client.end();
+    second.end();
+    CHECK(! late.begin());
+}
+
+#define DAEMON_SAMPLES 200
+#define DAEMON_PERIOD 10000
+
+static SimulatedTransport<1> *daemonBus;
+static INA260SharedPublisher *daemonPublisher;
+static volatile bool daemonRunning;
+
+static uint32_t daemonClock(void) {
+    return static_cast<uint32_t>(daemonBus->now());
+}
+
+static void daemonSleep(uint32_t us) {
+    daemonBus->advance(us);
+    if (daemonPublisher->getPublishedCount() >= DAEMON_SAMPLES - 1) {
+        daemonRunning = false;
+    }
+}
+
+// The acquisition daemon: waits for the client, then runs DAEMON_SAMPLES
+// periods of a simulated INA260 at 1 A and 12 V.
+static int runDaemon(int ready, int go) {
+    SimulatedTransport<1> bus;
+    INA260Model model;
+    model.setConstant(1000000, 12000000);
+    bus.attach(model);
+    INA260Device<SimulatedTransport<1> > ina(bus);
+    INA260SharedPublisher publisher(STRESS_NAME, 1024);
+    daemonBus = &bus;
+    daemonPublisher = &publisher;
+    daemonRunning = true;
+    if (! ina.begin() || ! publisher.begin()) {
+        return 1;
+    }
+    bus.advance(5000);
+    char byte = 0;
+    if (write(ready, &byte, 1) != 1 || read(go, &byte, 1) != 1) {
+        return 1;
+    }
+    const uint32_t failures = publisher.run(ina, DAEMON_PERIOD, daemonRunning, daemonClock, daemonSleep);
+    const uint32_t published = static_cast<uint32_t>(publisher.getPublishedCount());
+    if (write(ready, &published, sizeof(published)) != sizeof(published) || read(go, &byte, 1) != 1) {
+        return 1;
+    }
+    publisher.end();
+    return failures != 0;
+}
+
+static void forkedDaemonSamplesASimulatedDevice(void) {
+    int toClient[2];
+    int toDaemon[2];
+    CHECK(pipe(toClient) == 0 && pipe(toDaemon) == 0);
+    const pid_t daemon = fork();
+    if (daemon == 0) {
+        close(toClient[0]);
+        close(toDaemon[1]);
+        _exit(runDaemon(toClient[1], toDaemon[0]));
+    }
+    close(toClient[1]);
+    close(toDaemon[0]);
+
+    char byte = 0;
+    CHECK_EQUAL(1, read(toClient[0], &byte, 1));
+    INA260SharedClient client(STRESS_NAME);
+    CHECK(client.begin());
+    CHECK_EQUAL(1, write(toDaemon[1], &byte, 1));
+    uint32_t published = 0;
+    CHECK_EQUAL(sizeof(published), read(toClient[0], &published, sizeof(published)));
+
+    uint32_t received = 0;
+    uint32_t wrong = 0;
+    uint32_t badPeriod = 0;
+    RawSample sample = {};
+    RawSample previous = {};
+    while (client.next(sample)) {
+        if (sample.current != 0x0320 || sample.voltage != 0x2580 || sample.power != 1200) {
+            wrong++;
+        }
+        if (received > 0 && sample.micros - previous.micros != DAEMON_PERIOD) {
+            badPeriod++;
+        }
+        previous = sample;
+        received++;
+    }
+    CHECK_EQUAL(DAEMON_SAMPLES, published);
+    CHECK_EQUAL(DAEMON_SAMPLES, received);
+    CHECK_EQUAL(0, client.getLostCount());
+    CHECK_EQUAL(0, wrong);
+    CHECK_EQUAL(0, badPeriod);
+    RawSample latest = {};
+    CHECK(client.latest(latest));
+    CHECK_EQUAL(previous.micros, latest.micros);
+
+    CHECK_EQUAL(1, write(toDaemon[1], &byte, 1));
+    int status = -1;
+    CHECK_EQUAL(daemon, waitpid(daemon, &status, 0));
+    CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    client.end();
+}
+
+int main(void) {
+    clientSeesEverySampleOrCountsIt();
+    newPublisherLeavesOldClientsAlone();
+    forkedDaemonSamplesASimulatedDevice();
+    return checkResult();
+}
@@ -0,0 +1,43 @@
+#include "INA260.h"
+#include "INA260Model.h"
+#include "SimulatedTransport.h"
+
+#include "Check.h"
+
+/*!
+ *  @brief readSnapshot() against the device model: the values of a
+ *  retried bracketed snapshot still report a new conversion.
+*/
+
+static void retriedSnapshotsAreNew(void) {
+    SimulatedTransport<1> bus;
+    INA260Model model;
+    model.setConstant(1000000, 12000000);
+    bus.attach(model);
+    bus.setBusClock(400000);
+    INA260Device<SimulatedTransport<1> > ina(bus);
+    bus.advance(5000);
+
+    // 2.2 ms conversions against a ~0.6 ms bracketed read: some starting
+    // points see a conversion finish mid-sequence.
+    uint32_t retried = 0;
+    for (uint32_t i = 0; i < 200; i++) {
+        bus.advance(37);
+        Snapshot snapshot;
+        const uint32_t before = bus.transactions;
+        if (! ina.readSnapshot(snapshot, true)) {
+            continue;
+        }
+        if (bus.transactions - before > 5) {
+            retried++;
+            CHECK_EQUAL(1, snapshot.flags.cvrf);
+        }
+        CHECK_EQUAL(0x0320, snapshot.current);
+    }
+    CHECK(retried > 0);
+}
+
+int main(void) {
+    retriedSnapshotsAreNew();
+    return checkResult();
+}
@@ -0,0 +1,76 @@
+#include "INA260Static.h"
+#include "MockTransport.h"
+
+#include "Check.h"
+
+/*!
+ *  @brief INA260StaticDevice on MockTransport: the configuration word
+ *  begin() writes, the conversion period derived from it, and reads.
+*/
+
+typedef MockTransport<1> Bus;
+typedef INA260StaticDevice<Bus, ADDRESS_0x41, MODE_CONT_ISH_VBUS, AVG_64, TIME_1_1_ms, TIME_558_us, 7> Fast;
+typedef INA260StaticDevice<Bus, ADDRESS_0x41, MODE_TRIG_VBUS, AVG_1024, TIME_140_us, TIME_8_244_ms> Slow;
+
+static_assert(conversionTimeMicros(TIME_140_us) == 140 && conversionTimeMicros(TIME_8_244_ms) == 8244,
+              "conversion times are compile-time constants");
+static_assert(Fast::periodMicros == (1100 + 558) * 64, "both conversions, 64 times");
+static_assert(Slow::periodMicros == 8244 * 1024, "only the bus voltage conversion");
+
+static void beginWritesTheConfiguration(void) {
+    Bus bus;
+    Bus::Device *chip = bus.addDevice(0x41);
+    chip->registers[INA260_CONFIG_REGISTER] = 0;
+    Fast ina(bus);
+
+    CHECK(ina.begin());
+    CHECK_EQUAL(1, bus.writes);
+    CHECK_EQUAL(0, bus.writeReads);
+    ConfigurationRegister config;
+    config.rawValue = chip->registers[INA260_CONFIG_REGISTER];
+    CHECK_EQUAL(Fast::configuration, config.rawValue);
+    CHECK_EQUAL(MODE_CONT_ISH_VBUS, config.mode);
+    CHECK_EQUAL(AVG_64, config.avg);
+    CHECK_EQUAL(TIME_1_1_ms, config.ishct);
+    CHECK_EQUAL(TIME_558_us, config.vbusct);
+    CHECK_EQUAL(0, config.rst);
+    // Reserved bits as after reset.
+    CHECK_EQUAL(INA260_CONFIG_DEFAULT & 0x7000, config.rawValue & 0x7000);
+    // The driver's runtime period agrees with the compile-time one.
+    CHECK_EQUAL(Fast::periodMicros, conversionPeriodMicros(config));
+
+    Slow slow(bus);
+    CHECK(slow.begin());
+    config.rawValue = chip->registers[INA260_CONFIG_REGISTER];
+    CHECK_EQUAL(Slow::configuration, config.rawValue);
+    CHECK_EQUAL(Slow::periodMicros, conversionPeriodMicros(config));
+    CHECK(slow.trigger());
+    CHECK_EQUAL(3, bus.writes);
+}
+
+static void readsGoStraightToTheBus(void) {
+    Bus bus;
+    Bus::Device *chip = bus.addDevice(0x41);
+    chip->registers[INA260_CURRENT_REGISTER] = 0xFCE0;             // -1 A
+    chip->registers[INA260_VOLTAGE_REGISTER] = 0x2580;             // 12 V
+    chip->registers[INA260_POWER_REGISTER] = 0x04B0;               // 12 W
+    Fast ina(bus);
+
+    CHECK_EQUAL(-1000000, ina.readCurrentMicroAmps());
+    CHECK_EQUAL(12000000, ina.readBusVoltageMicroVolts());
+    CHECK_EQUAL(12000000, ina.readPowerMicroWatts());
+    CHECK_EQUAL(3, bus.writeReads);
+
+    // Failed reads give 0.
+    bus.failNext = 1;
+    CHECK_EQUAL(0, ina.readCurrentMicroAmps());
+    Bus empty;
+    Fast missing(empty);
+    CHECK(! missing.begin());
+}
+
+int main(void) {
+    beginWritesTheConfiguration();
+    readsGoStraightToTheBus();
+    return checkResult();
+}
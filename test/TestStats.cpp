@@ -0,0 +1,53 @@
+#include <string.h>
+
+#include "INA260.h"
+#include "INA260Budget.h"
+#include "MockTransport.h"
+
+#include "Check.h"
+
+/*!
+ *  @brief Per-call bytes and latency in the INA260_ENABLE_STATS counters.
+ *  Built with INA260_ENABLE_STATS defined.
+*/
+
+static bool sawSnapshot = false;
+
+static void findSnapshot(const char *line, void *) {
+    if (strncmp(line, "readSnapshot ", 13) == 0) {
+        sawSnapshot = true;
+    }
+}
+
+static void bytesAndTimeAreChargedToTheCall(void) {
+    MockTransport<1> bus;
+    bus.addDevice(0x40);
+    INA260Device<MockTransport<1> > ina(bus);
+
+    Snapshot snapshot;
+    ina.readSnapshot(snapshot, true);
+    ina.readCurrent();
+    ina.readCurrent();
+
+    const INA260Stats &stats = ina.getStats();
+    const ApiStats &snapshots = stats.apis[API_READ_SNAPSHOT];
+    CHECK_EQUAL(1, snapshots.calls);
+    CHECK_EQUAL(5, snapshots.transactions);
+    CHECK_EQUAL(5 * 3, snapshots.bytes);
+    CHECK(snapshots.totalMicros >= snapshots.maxMicros);
+
+    // The second read reuses the pointer the first one sent.
+    const ApiStats &currents = stats.apis[API_READ_CURRENT];
+    CHECK_EQUAL(2, currents.calls);
+    CHECK_EQUAL(3 + 2, currents.bytes);
+
+    stats.dump(findSnapshot);
+    CHECK(sawSnapshot);
+
+    CHECK_EQUAL(0, checkBudget(stats));
+}
+
+int main(void) {
+    bytesAndTimeAreChargedToTheCall();
+    return checkResult();
+}
@@ -0,0 +1,203 @@
+#include "INA260.h"
+#include "INA260Budget.h"
+#include "MockTransport.h"
+
+#include "Check.h"
+
+/*!
+ *  @brief Exact bus traffic of every public INA260Device call on
+ *  MockTransport: register writes, reads that sent the pointer and reads
+ *  that reused it. Built with INA260_ENABLE_STATS so the per-call budget
+ *  table is checked against the same calls.
+ *
+ *  Every call starts with the transport's pointers forgotten, so reads
+ *  only reuse a pointer the call itself sent.
+*/
+
+typedef MockTransport<1> Bus;
+
+static Bus bus;
+static Bus::Device *chip;
+
+static void noSleep(uint32_t) {}
+
+// Sets the Conversion Ready Flag just before measureOnce()'s last check.
+static uint32_t sleeps;
+static void readyAtLastCheck(uint32_t) {
+    if (++sleeps == INA260_TRIGGER_ATTEMPTS) {
+        chip->registers[INA260_MASK_ENABLE_REGISTER] = 0x0008;
+    }
+}
+
+#define CHECK_TRAFFIC(call, expectedWrites, expectedPointerReads, expectedCachedReads) do { \
+        bus.pointers().clear(); \
+        bus.resetCounters(); \
+        call; \
+        if (bus.writes != (expectedWrites) || bus.writeReads != (expectedPointerReads) || \
+            bus.reads != (expectedCachedReads)) { \
+            printf("%s:%d: %s made %lu writes, %lu reads, %lu cached reads; expected %d, %d, %d\n", \
+                   __FILE__, __LINE__, #call, (unsigned long)bus.writes, (unsigned long)bus.writeReads, \
+                   (unsigned long)bus.reads, (expectedWrites), (expectedPointerReads), (expectedCachedReads)); \
+            checkFailures++; \
+        } \
+    } while (0)
+
+static void setUp(void) {
+    chip = bus.addDevice(INA260_I2CADDR_DEFAULT);
+    chip->registers[INA260_CONFIG_REGISTER] = INA260_CONFIG_DEFAULT;
+    chip->registers[INA260_CURRENT_REGISTER] = 0x0320;
+    chip->registers[INA260_MANUFACTURER_ID_REGISTER] = INA260_MANUFACTURER_ID;
+    chip->registers[INA260_DIE_ID_REGISTER] = 0x2270;
+}
+
+static void withoutShadowRegisters(INA260Device<Bus> &ina) {
+    uint16_t value;
+    uint8_t found[16];
+    Snapshot snapshot;
+
+    CHECK_TRAFFIC(ina.begin(), 1, 0, 0);
+    CHECK_TRAFFIC(ina.reset(), 1, 0, 0);
+    CHECK_TRAFFIC(ina.findDevices(), 0, 0, 0);
+    CHECK_EQUAL(126, bus.probes);
+    CHECK_TRAFFIC(ina.scanDevices(found, 16), 0, 2, 0);
+    CHECK_EQUAL(16, bus.probes);
+
+    CHECK_TRAFFIC(ina.setAddress(INA260_I2CADDR_DEFAULT), 0, 0, 0);
+    CHECK_TRAFFIC(ina.getAddress(), 0, 0, 0);
+    CHECK_TRAFFIC(ina.transport(), 0, 0, 0);
+    CHECK_TRAFFIC(ina.setPointerCache(true), 0, 0, 0);
+    CHECK_TRAFFIC(ina.invalidatePointerCache(), 0, 0, 0);
+    CHECK_TRAFFIC(ina.isPointerCacheEnabled(), 0, 0, 0);
+    CHECK_TRAFFIC(ina.isShadowRegistersEnabled(), 0, 0, 0);
+    CHECK_TRAFFIC(ina.resync(), 0, 2, 0);
+    CHECK_TRAFFIC(ina.getLastStatus(), 0, 0, 0);
+
+    CHECK_TRAFFIC(ina.readRegister(INA260_CURRENT_REGISTER), 0, 1, 0);
+    CHECK_TRAFFIC(ina.readRegister(INA260_CURRENT_REGISTER, value), 0, 1, 0);
+    CHECK_TRAFFIC(ina.tryReadRegister(INA260_CURRENT_REGISTER), 0, 1, 0);
+    CHECK_TRAFFIC(ina.writeRegister(INA260_ALERT_LIMIT_REGISTER, 0), 1, 0, 0);
+
+    CHECK_TRAFFIC(ina.readConfigurationRegister(), 0, 1, 0);
+    CHECK_TRAFFIC(ina.tryReadConfigurationRegister(), 0, 1, 0);
+    CHECK_TRAFFIC(ina.writeConfigurationRegister(ina.configureDefaults().value()), 1, 0, 0);
+    CHECK_TRAFFIC(ina.configure().mode(MODE_CONT_ISH_VBUS).averagingCount(AVG_4).commit(), 1, 1, 0);
+    CHECK_TRAFFIC(ina.configureDefaults().commit(), 1, 0, 0);
+
+    CHECK_TRAFFIC(ina.readCurrent(), 0, 1, 0);
+    CHECK_TRAFFIC(ina.readBusVoltage(), 0, 1, 0);
+    CHECK_TRAFFIC(ina.readPower(), 0, 1, 0);
+    CHECK_TRAFFIC(ina.tryReadCurrent(), 0, 1, 0);
+    CHECK_TRAFFIC(ina.tryReadBusVoltage(), 0, 1, 0);
+    CHECK_TRAFFIC(ina.tryReadPower(), 0, 1, 0);
+    CHECK_TRAFFIC(ina.readCurrentMicroAmps(), 0, 1, 0);
+    CHECK_TRAFFIC(ina.readBusVoltageMicroVolts(), 0, 1, 0);
+    CHECK_TRAFFIC(ina.readPowerMicroWatts(), 0, 1, 0);
+    CHECK_TRAFFIC(ina.readCurrent(); ina.readCurrent(), 0, 1, 1);
+
+    CHECK_TRAFFIC(ina.readSnapshot(snapshot), 0, 4, 0);
+    CHECK_TRAFFIC(ina.readSnapshot(snapshot, true), 0, 5, 0);
+
+    CHECK_TRAFFIC(ina.readMaskEnableRegister(), 0, 1, 0);
+    CHECK_TRAFFIC(ina.tryReadMaskEnableRegister(), 0, 1, 0);
+    CHECK_TRAFFIC(ina.writeMaskEnableRegister(MaskEnableRegister()), 1, 0, 0);
+
+    CHECK_TRAFFIC(ina.readAlertLimitRegister(), 0, 2, 0);
+    CHECK_TRAFFIC(ina.tryReadAlertLimitRegister(), 0, 2, 0);
+    CHECK_TRAFFIC(ina.writeAlertLimitRegister(100), 1, 0, 0);
+
+    CHECK_TRAFFIC(ina.enableOverCurrentLimitAlert(1000), 2, 1, 0);
+    CHECK_TRAFFIC(ina.enableUnderCurrentLimitAlert(1000), 2, 1, 0);
+    CHECK_TRAFFIC(ina.enableBusOvertLimitAlert(12000), 2, 1, 0);
+    CHECK_TRAFFIC(ina.enableBusUnderLimitAlert(12000), 2, 1, 0);
+    CHECK_TRAFFIC(ina.enableOverPowerLimitAlert(10000), 2, 1, 0);
+
+    CHECK_TRAFFIC(ina.setCurrentLimit(1000), 1, 0, 0);
+    CHECK_TRAFFIC(ina.setBusVoltageLimit(12000), 1, 0, 0);
+    CHECK_TRAFFIC(ina.setPowerLimit(10000), 1, 0, 0);
+
+    CHECK_TRAFFIC(ina.isMathOverFlow(), 0, 1, 0);
+    CHECK_TRAFFIC(ina.isAlert(), 0, 1, 0);
+    CHECK_TRAFFIC(ina.clearAlert(), 0, 1, 0);
+    CHECK_TRAFFIC(ina.isAlertPolaritySet(), 0, 1, 0);
+    CHECK_TRAFFIC(ina.setAlertPolarity(false), 1, 1, 0);
+    CHECK_TRAFFIC(ina.isAlertLatchSet(), 0, 1, 0);
+    CHECK_TRAFFIC(ina.setAlertLatch(false), 1, 1, 0);
+
+    CHECK_TRAFFIC(ina.getMode(), 0, 1, 0);
+    CHECK_TRAFFIC(ina.setMode(MODE_CONT_ISH_VBUS), 1, 1, 0);
+    CHECK_TRAFFIC(ina.isConversionRready(), 0, 1, 0);
+    CHECK_TRAFFIC(ina.setConversionReadyAlert(false), 1, 1, 0);
+    CHECK_TRAFFIC(ina.getCurrentConversionTime(), 0, 1, 0);
+    CHECK_TRAFFIC(ina.setCurrentConversionTime(TIME_1_1_ms), 1, 1, 0);
+    CHECK_TRAFFIC(ina.getVoltageConversionTime(), 0, 1, 0);
+    CHECK_TRAFFIC(ina.setVoltageConversionTime(TIME_1_1_ms), 1, 1, 0);
+    CHECK_TRAFFIC(ina.getAveragingCount(), 0, 1, 0);
+    CHECK_TRAFFIC(ina.setAveragingCount(AVG_1), 1, 1, 0);
+
+    CHECK_TRAFFIC(ina.readDieId(), 0, 1, 0);
+    CHECK_TRAFFIC(ina.tryReadDieId(), 0, 1, 0);
+
+    // A triggered conversion that is ready at the first check.
+    ina.setMode(MODE_TRIG_ISH_VBUS);
+    chip->registers[INA260_MASK_ENABLE_REGISTER] = 0x0008;
+    CHECK_TRAFFIC(ina.measureOnce(snapshot, noSleep), 1, 5, 0);
+    // Never ready: the first check sends the pointer, the rest reuse it.
+    chip->registers[INA260_MASK_ENABLE_REGISTER] = 0;
+    CHECK_TRAFFIC(ina.measureOnce(snapshot, noSleep), 1, 2, INA260_TRIGGER_ATTEMPTS - 1);
+    // Ready at the last check: the worst case the budget allows for.
+    sleeps = 0;
+    CHECK_TRAFFIC(CHECK(ina.measureOnce(snapshot, readyAtLastCheck)), 1, 5, INA260_TRIGGER_ATTEMPTS - 1);
+    CHECK_EQUAL(transactionBudget(API_MEASURE_ONCE), ina.getStats().apis[API_MEASURE_ONCE].maxTransactions);
+    chip->registers[INA260_MASK_ENABLE_REGISTER] = 0;
+    ina.setMode(MODE_CONT_ISH_VBUS);
+}
+
+static void withShadowRegisters(INA260Device<Bus> &ina) {
+    Snapshot snapshot;
+
+    CHECK_TRAFFIC(ina.setShadowRegisters(true), 0, 2, 0);
+
+    CHECK_TRAFFIC(ina.readConfigurationRegister(), 0, 0, 0);
+    CHECK_TRAFFIC(ina.configure().averagingCount(AVG_16).commit(), 1, 0, 0);
+    CHECK_TRAFFIC(ina.readAlertLimitRegister(), 0, 1, 0);
+    CHECK_TRAFFIC(ina.enableOverCurrentLimitAlert(1000), 2, 0, 0);
+    CHECK_TRAFFIC(ina.isAlertPolaritySet(), 0, 0, 0);
+    CHECK_TRAFFIC(ina.setAlertPolarity(false), 1, 0, 0);
+    CHECK_TRAFFIC(ina.isAlertLatchSet(), 0, 0, 0);
+    CHECK_TRAFFIC(ina.setAlertLatch(false), 1, 0, 0);
+    CHECK_TRAFFIC(ina.setConversionReadyAlert(false), 1, 0, 0);
+    CHECK_TRAFFIC(ina.getMode(), 0, 0, 0);
+    CHECK_TRAFFIC(ina.setMode(MODE_CONT_ISH_VBUS), 1, 0, 0);
+    CHECK_TRAFFIC(ina.getCurrentConversionTime(), 0, 0, 0);
+    CHECK_TRAFFIC(ina.setCurrentConversionTime(TIME_1_1_ms), 1, 0, 0);
+    CHECK_TRAFFIC(ina.getVoltageConversionTime(), 0, 0, 0);
+    CHECK_TRAFFIC(ina.setVoltageConversionTime(TIME_1_1_ms), 1, 0, 0);
+    CHECK_TRAFFIC(ina.getAveragingCount(), 0, 0, 0);
+    CHECK_TRAFFIC(ina.setAveragingCount(AVG_1), 1, 0, 0);
+
+    // Flags are never shadowed.
+    CHECK_TRAFFIC(ina.isAlert(), 0, 1, 0);
+    CHECK_TRAFFIC(ina.readSnapshot(snapshot), 0, 4, 0);
+
+    ina.setMode(MODE_TRIG_ISH_VBUS);
+    chip->registers[INA260_MASK_ENABLE_REGISTER] = 0x0008;
+    CHECK_TRAFFIC(ina.measureOnce(snapshot, noSleep), 1, 4, 0);
+    chip->registers[INA260_MASK_ENABLE_REGISTER] = 0;
+
+    CHECK_TRAFFIC(ina.setShadowRegisters(false), 0, 0, 0);
+}
+
+static void printViolation(const char *line, void *) {
+    printf("budget: %s\n", line);
+}
+
+int main(void) {
+    setUp();
+    INA260Device<Bus> ina(bus);
+    withoutShadowRegisters(ina);
+    withShadowRegisters(ina);
+
+    // Every call above stays within its budget.
+    CHECK_EQUAL(0, checkBudget(ina.getStats(), printViolation));
+    return checkResult();
+}
@@ -0,0 +1,139 @@
+#include <math.h>
+#include <stdlib.h>
+
+#include "INA260WindowStats.h"
+
+#include "Check.h"
+
+/*!
+ *  @brief INA260TumblingStats and INA260SlidingStats against brute-force
+ *  recomputation, and the exact variance at the largest window.
+*/
+
+// Pseudo-random register values covering the signed and unsigned ranges.
+static int32_t value(uint32_t i) {
+    return static_cast<int32_t>((i * 2654435761u) >> 15) % 65536 - 32768 + static_cast<int32_t>(i % 3) * 16000;
+}
+
+static WindowSummary bruteForce(const int32_t *values, uint16_t count) {
+    WindowSummary summary = WindowSummary();
+    for (uint16_t i = 0; i < count; i++) {
+        if (i == 0 || values[i] < summary.min) {
+            summary.min = values[i];
+        }
+        if (i == 0 || values[i] > summary.max) {
+            summary.max = values[i];
+        }
+        summary.sum += values[i];
+        summary.sumSquares += static_cast<uint64_t>(static_cast<int64_t>(values[i]) * values[i]);
+    }
+    summary.count = count;
+    return summary;
+}
+
+static bool sameSummary(const WindowSummary &a, const WindowSummary &b) {
+    return a.count == b.count && a.min == b.min && a.max == b.max &&
+           a.sum == b.sum && a.sumSquares == b.sumSquares;
+}
+
+static void tumblingClosesBySizeAndByCall(void) {
+    INA260TumblingStats stats(4);
+    int32_t values[10];
+    WindowSummary closed = WindowSummary();
+    uint8_t windows = 0;
+    for (uint32_t i = 0; i < 10; i++) {
+        values[i] = value(i);
+        if (stats.add(values[i], closed)) {
+            CHECK(sameSummary(bruteForce(&values[windows * 4], 4), closed));
+            windows++;
+        }
+        CHECK_EQUAL((i + 1) % 4, stats.current().count);
+    }
+    CHECK_EQUAL(2, windows);
+
+    // close() ends the partial window early, and then there is nothing left.
+    CHECK(stats.close(closed));
+    CHECK(sameSummary(bruteForce(&values[8], 2), closed));
+    CHECK(! stats.close(closed));
+    CHECK_EQUAL(0, stats.current().count);
+
+    // A size of 0 is treated as 1.
+    INA260TumblingStats single(0);
+    CHECK(single.add(-5, closed));
+    CHECK_EQUAL(1, closed.count);
+    CHECK_EQUAL(-5, closed.min);
+    CHECK_EQUAL(-5, closed.max);
+}
+
+static void slidingMatchesBruteForce(void) {
+    INA260SlidingStats<7> stats;
+    CHECK_EQUAL(0, stats.summary().count);
+    int32_t values[300];
+    for (uint32_t i = 0; i < 300; i++) {
+        // Runs of rising and falling values stress the min/max queues.
+        values[i] = (i % 50 < 25) ? value(i) : static_cast<int32_t>(i % 25) * ((i & 64) ? 1000 : -1000);
+        stats.add(values[i]);
+        const uint16_t count = (i + 1 < 7) ? i + 1 : 7;
+        const WindowSummary expected = bruteForce(&values[i + 1 - count], count);
+        const WindowSummary actual = stats.summary();
+        if (! sameSummary(expected, actual)) {
+            printf("sample %u: window differs\n", i);
+            checkFailures++;
+        }
+        CHECK_EQUAL(expected.varianceNumerator(), actual.varianceNumerator());
+
+        // The variance against a two-pass recomputation in double.
+        double mean = 0.0;
+        for (uint16_t j = 0; j < count; j++) {
+            mean += values[i + 1 - count + j];
+        }
+        mean /= count;
+        double variance = 0.0;
+        for (uint16_t j = 0; j < count; j++) {
+            const double d = values[i + 1 - count + j] - mean;
+            variance += d * d;
+        }
+        variance /= count;
+        CHECK(fabs(actual.variance() - variance) <= 1e-9 * (variance + 1.0));
+        CHECK(fabs(actual.mean() - mean) <= 1e-9);
+    }
+
+    stats.reset();
+    CHECK_EQUAL(0, stats.summary().count);
+    stats.add(3);
+    CHECK_EQUAL(3, stats.summary().min);
+    CHECK_EQUAL(3, stats.summary().max);
+}
+
+static void exactVarianceAtTheLargestWindow(void) {
+    INA260TumblingStats stats;
+    WindowSummary closed = WindowSummary();
+    // Alternating +/-65535, one more positive than negative.
+    for (uint32_t i = 0; i < INA260_WINDOW_MAX; i++) {
+        const bool full = stats.add((i & 1) ? -65535 : 65535, closed);
+        CHECK_EQUAL(i == INA260_WINDOW_MAX - 1, full);
+    }
+    CHECK_EQUAL(INA260_WINDOW_MAX, closed.count);
+    CHECK_EQUAL(65535, closed.sum);
+    CHECK_EQUAL(-65535, closed.min);
+    CHECK_EQUAL(65535, closed.max);
+    // count x sumSquares = 65535^4, just under 2^64.
+    const uint64_t square = 65535ULL * 65535ULL;
+    CHECK(closed.varianceNumerator() == square * square - square);
+    CHECK(fabs(closed.variance() - (square - 1.0)) < 1e-3);
+
+    // The same magnitude everywhere has no variance.
+    for (uint32_t i = 0; i < INA260_WINDOW_MAX; i++) {
+        stats.add(-65535, closed);
+    }
+    CHECK(closed.varianceNumerator() == 0);
+    CHECK(closed.rms() == 65535.0);
+    CHECK(closed.standardDeviation() == 0.0);
+}
+
+int main(void) {
+    tumblingClosesBySizeAndByCall();
+    slidingMatchesBruteForce();
+    exactVarianceAtTheLargestWindow();
+    return checkResult();
+}